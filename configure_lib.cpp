@@ -9,13 +9,16 @@
  * to run the configure_lib.cpp file
  * 
  * \code{.sh}
- *  $ g++ configure_lib.cpp -o configure_lib -DSET_LEAF_SIZE && ./configure_lib <N_epoch>
+ *  $ g++ -std=c++17 configure_lib.cpp -o configure_lib -DSET_LEAF_SIZE -pthread && ./configure_lib <N_epoch>
  * \endcode
  * 
  * The program begins with LEAF_SIZE = 8, calls MATOPS::BigMatrix<Data1>::matmul() N_epoch times and calculates the average execution time of matmul 
  * over all the calls and stores it in a varaible min_time. It continues doing the same for LEAF_SIZE=16, 32,64 ..... as min_time keeps reducing.
  * As soon as the value of min_time starts increasing we break out of the inifinite while loop and store the LEAF_SIZE value that gave the least min_time
  * in a configure.txt file. This file is later used by matmul to multiply big matrices.
+ * The same value is also written to a generated matrix_config.h header as a constexpr, which lets MATOPS::TunedBigMatrix fix the LEAF_SIZE at
+ * compile time instead of reading configure.txt at run time. matrix.h includes matrix_config.h whenever it finds it, so a stale copy (from another
+ * machine or an older run) silently changes the compiled constants; the file is machine specific and kept out of git.
  *  
  * @author Shiladitya Biswas
  * @version 0.1
@@ -85,6 +88,20 @@ int main(int argc, char** argv){
         file<<final_leaf_size<<'\n';  // Store the Optimal LEAF_SIZE value in a txt file 
         cout<<"configure.txt File Generated \n";
         file.close();
+
+        // Store the same value as a compile time constant for MATOPS::TunedBigMatrix
+        std::ofstream header;
+        header.open("matrix_config.h");
+        header<<"// Generated by configure_lib.cpp, re-run the configuration instead of editing this file.\n"
+              <<"#ifndef MATRIX_CONFIG_H_\n"
+              <<"#define MATRIX_CONFIG_H_\n\n"
+              <<"#define MATOPS_HAVE_TUNED_CONFIG\n\n"
+              <<"namespace MATOPS\n{\n"
+              <<"\tconstexpr int TUNED_LEAF_SIZE="<<final_leaf_size<<"; // Optimal LEAF_SIZE of this machine\n"
+              <<"}\n\n"
+              <<"#endif /* MATRIX_CONFIG_H_ */\n";
+        header.close();
+        cout<<"matrix_config.h File Generated \n";
         // cout<<"Best Leaf size = "<<final_leaf_size<<'\n';
 
     return 0;
@@ -0,0 +1,142 @@
+/**
+ * @file matops_service.cpp
+ *
+ * @brief Command line front end of MATOPS::MatmulService and MATOPS::MatmulClient. It starts the resident multiplication service on a Unix domain
+ * socket and sends it requests, so the service can be exercised end to end on one machine. Compile it with
+ *
+ * \code{.sh}
+ *  $ g++ -std=c++17 matops_service.cpp -o matops_service -pthread
+ * \endcode
+ *
+ * and use it as follows (operands and results are csv paths or "shm:<name>" shared memory segments):
+ *
+ * \code{.sh}
+ *  $ ./matops_service serve /tmp/matops.sock double 8 &          # type (float|double), threads, operand cache in MB are optional
+ *  $ ./matops_service matmul /tmp/matops.sock A.csv B.csv C.csv
+ *  $ ./matops_service put double A.csv /A                         # copy A.csv into the shared memory segment /A
+ *  $ ./matops_service matmul /tmp/matops.sock shm:/A B.csv shm:/C
+ *  $ ./matops_service get double /C C.csv                         # copy (and remove) the segment /C into C.csv
+ *  $ ./matops_service transpose /tmp/matops.sock A.csv A_trans.csv
+ *  $ ./matops_service stats /tmp/matops.sock
+ *  $ ./matops_service shutdown /tmp/matops.sock
+ * \endcode
+ *
+ * The service reads configure.txt from its working directory once at startup.
+ *
+ */
+
+#include<iostream>
+#include "matrix.h"
+#include<vector>
+#include<string>
+
+using namespace std;
+using namespace MATOPS; //namespace for matrix.h
+
+// Print the usage of the command line front end.
+void usage()
+{
+	cerr<<"Usage:\n"
+		<<"  matops_service serve <socket> [float|double] [n_threads] [cache_MB]\n"
+		<<"  matops_service matmul <socket> <A> <B> <C>\n"
+		<<"  matops_service transpose <socket> <A> <C>\n"
+		<<"  matops_service stats|ping|shutdown <socket>\n"
+		<<"  matops_service put <float|double> <file.csv> <shm_name>\n"
+		<<"  matops_service get <float|double> <shm_name> <file.csv>\n";
+}
+
+// Run the service for one datatype until it is shut down.
+template<typename T>
+void serve(const string &socket_path, size_t n_threads, size_t cache_bytes)
+{
+	MatmulService<T> service(socket_path,n_threads,cache_bytes);
+	cout<<"Listening on "<<socket_path<<endl;
+	service.run();
+}
+
+// Copy a csv file into a shared memory segment, or a segment into a csv file.
+template<typename T>
+void copy_operand(const string &command, const string &from, const string &to)
+{
+	if(command=="put")
+	{
+		BigMatrix<T> MatObj;
+		store_shm<T>(to,MatObj.load(from).to_vector());
+	}
+	else if(!store_csv<T>(load_shm<T>(from,true),to))
+	{
+		throw runtime_error("Can't write to file path: '"+to+"'");
+	}
+}
+
+int main(int argc, char** argv)
+{
+	if(argc<3)
+	{
+		usage();
+		return 1;
+	}
+	string command=argv[1];
+	try{
+		if(command=="serve")
+		{
+			string type= (argc>3)? argv[3] : "double";
+			size_t n_threads= (argc>4)? stoul(argv[4]) : 0;
+			size_t cache_bytes= ((argc>5)? stoul(argv[5]) : 1024)<<20;
+			if(type=="float")
+			{
+				serve<float>(argv[2],n_threads,cache_bytes);
+			}
+			else
+			{
+				serve<double>(argv[2],n_threads,cache_bytes);
+			}
+			return 0;
+		}
+		if((command=="put" || command=="get") && argc==5)
+		{
+			if(string(argv[2])=="float")
+			{
+				copy_operand<float>(command,argv[3],argv[4]);
+			}
+			else
+			{
+				copy_operand<double>(command,argv[3],argv[4]);
+			}
+			return 0;
+		}
+
+		MatmulClient client(argv[2]);
+		if(command=="matmul" && argc==6)
+		{
+			cout<<client.matmul(argv[3],argv[4],argv[5])<<'\n';
+		}
+		else if(command=="transpose" && argc==5)
+		{
+			cout<<client.transpose(argv[3],argv[4])<<'\n';
+		}
+		else if(command=="stats")
+		{
+			cout<<client.stats()<<'\n';
+		}
+		else if(command=="ping")
+		{
+			client.ping();
+			cout<<"OK\n";
+		}
+		else if(command=="shutdown")
+		{
+			client.shutdown();
+		}
+		else
+		{
+			usage();
+			return 1;
+		}
+	}catch (const exception &err)
+	{
+		cerr<<err.what()<<'\n';
+		return 1;
+	}
+	return 0;
+}
@@ -12,6 +12,10 @@
 #ifndef MATRIX_H_
 #define MATRIX_H_
 
+#if __cplusplus < 201703L && !(defined(_MSVC_LANG) && _MSVC_LANG >= 201703L)
+#error "matrix.h needs C++17 (<filesystem>, std::aligned_alloc), compile with -std=c++17"
+#endif
+
 #include<iostream>
 #include<stddef.h>
 #include<vector>
@@ -20,6 +24,49 @@
 #include<sstream>
 #include<fstream>
 #include<string.h>
+#include<thread>
+#include<mutex>
+#include<condition_variable>
+#include<future>
+#include<functional>
+#include<queue>
+#include<map>
+#include<memory>
+#include<chrono>
+#include<algorithm>
+#include<limits>
+#include<cmath>
+#include<cstdint>
+#include<filesystem>
+#include<typeinfo>
+#include<complex>
+#include<cstdlib>
+#include<type_traits>
+#include<atomic>
+#include<set>
+#include<cerrno>
+#ifdef __AVX2__
+#include<immintrin.h>
+#endif
+#ifdef __linux__
+#include<fcntl.h>
+#include<unistd.h>
+#include<sched.h>
+#include<pthread.h>
+#include<sys/ioctl.h>
+#include<sys/mman.h>
+#include<sys/socket.h>
+#include<sys/un.h>
+#include<sys/stat.h>
+#include<sys/wait.h>
+#include<signal.h>
+#include<linux/fs.h>
+#endif
+#if defined(__has_include)
+#if __has_include("matrix_config.h")
+#include "matrix_config.h" // Tuned constants generated by configure_lib.cpp
+#endif
+#endif
 
 /**
  * @brief The main matrix.h namespace named MATOPS- MATrix OPerations. It contains 2 Matrix classes, namely class Matrix and class BigMatrix to perform matrix operations.
@@ -261,644 +308,6487 @@ namespace MATOPS
 
 
 		}; // Matrix Template Class Ends here !!!
-//=====================================================================================================================================
 
-		// CSV File storing
 		/**
-		 * @brief Function template to Store csv file at a given destination file. This function is internally called by matmul and Transpose 
-		 * function (with Data2:= int, float etc) to store the Resultant BigMatrix from the memory to a CSV file.
-		 * @tparam Data2
-		 * @param C = A Pointer pointing to the 2D BigMatrix in the memory
-		 * @param m_1 = No. of Rows of the Resultant BigMatrix
-		 * @param n_2 = No. of Columns of the Resultant BigMatrix
-		 * @param path = "path to destination csv file"
+		 * @brief GEMM for small matrices: C = alpha * op(A) x op(B) + beta * C, where op(X) is X or its transpose. The transposes are applied by the way the
+		 * operands are indexed, no transposed copy is made. The dimensions are checked at compile time. With beta == 0 the old C isn't read. C may be A or B.
+		 * Eg. MATOPS::gemm<true,false>(1.0, A, B, 0.0, C) computes C = A^T x B.
+		 * @tparam TRANS_A = Use the transpose of A
+		 * @tparam TRANS_B = Use the transpose of B
 		 */
-		template<typename Data2>
-				void store_csv(Data2 ** C, int m_1, int n_2, std::string path)
-					{
-						std::ofstream file;
-						file.open(path);
-
-						for(int i=0;i<m_1;i++)
-						{
-							for(int j=0;j<n_2;j++)
-							{
-								file<<C[i][j];
-								if(j<(n_2)-1)
-								{
-									file<<",";
-								}
-								else
-								{
-									file<<"\n";
-								}
-							}
-						}
-						file.close();
+		template<bool TRANS_A, bool TRANS_B, typename T, size_t a_m, size_t a_n, size_t b_m, size_t b_n, size_t c_m, size_t c_n>
+		void gemm(T alpha, const Matrix<T,a_m,a_n> &A, const Matrix<T,b_m,b_n> &B, T beta, Matrix<T,c_m,c_n> &C)
+		{
+			const size_t m= TRANS_A? a_n : a_m;
+			const size_t k= TRANS_A? a_m : a_n;
+			static_assert((TRANS_B? b_n : b_m)==(TRANS_A? a_m : a_n), "Matrix Inner Dimensions don't match can't multiply!!!");
+			static_assert((TRANS_A? a_n : a_m)==c_m && (TRANS_B? b_m : b_n)==c_n, "Dimensions of C don't match the product");
+			const size_t n= TRANS_B? b_m : b_n;
 
+			// The product goes to a temporary first, so C may be the same object as A or B (Eg. gemm<false,false>(1, A, A, 0, A)).
+			Matrix<T,c_m,c_n> P;
+			for(size_t i=0;i<m;i++)
+			{
+				for(size_t j=0;j<n;j++)
+				{
+					T sum=T(0);
+					for(size_t l=0;l<k;l++)
+					{
+						sum+= (TRANS_A? A.ElementAt(l,i) : A.ElementAt(i,l)) * (TRANS_B? B.ElementAt(j,l) : B.ElementAt(l,j));
 					}
-
-		// Template to convert variable type from string to int,float, double or any other Datatype
-		/**
-		 * @brief Function template to convert variable type from string to int,float, double or any other Datatype spcified by My_data.
-		 * @tparam My_data = Datatype into which we want to convert the string inputs parsed from CSV files.
-		 * @param str = String input from the Csv file.
-		 * @return Returns Converted number from string to My_data.
-		 */
-		template<typename My_data> My_data convert_to(const std::string &str)
+					P.ElementAt(i,j)=sum;
+				}
+			}
+			for(size_t i=0;i<m;i++)
 			{
-				std::istringstream ss(str); 
-
-				My_data num;
-
-				ss>>num;
-				return num;
+				for(size_t j=0;j<n;j++)
+				{
+					C.ElementAt(i,j)= (beta!=T(0))? alpha*P.ElementAt(i,j)+beta*C.ElementAt(i,j) : alpha*P.ElementAt(i,j);
+				}
 			}
-
+		}
+//=====================================================================================================================================
 
 		/**
-		 * @brief This is the Class for handling Large Matrices. It takes in large Matrices stored as comma-separated values (CSV) files and perform both Multiplication 
-		 * (Strassan's Algorithm) and transpose. It contains all the important functions namely ,matmul function, StrassanMultiply function and other helper functions 
-		 * that are needed for smooth functioning of the library. This class also contains blocks of code that are gated by the SET_LEAF_SIZE flag, for example the 
-		 * set_LEAF_SIZE() function and the set_configerd_Leaf_size() function. When matrix.h is compiled with the SET_LEAF_SIZE flag raised the set_LEAF_SIZE() function is active
-		 * and set_configerd_Leaf_size() function is inactive. And the vice-versa happens when matrix.h is compiled without the SET_LEAF_SIZE flag.
-		 * 
-		 * @tparam Data1 = Datatype of the BigMatrix. Eg. int, float, double etc.
+		 * @brief Matrix whose dimensions are only known at run time. It fills the gap between class Matrix (dimensions fixed at compile time and stored
+		 * on the stack, hence limited to small sizes) and class BigMatrix (file based). The elements are stored row major in one contiguous block:
+		 * matrices of up to INLINE_SIZE elements live inside the object itself (no allocation at all), larger ones in a 64 byte aligned heap buffer.
+		 * The class is move-only, moving a heap backed DynMatrix transfers its buffer instead of copying it, an explicit copy is made with clone().
+		 * Dimensions whose buffer size doesn't fit a size_t throw std::length_error.
+		 * @tparam T = DataType of the Matrix, must be trivially copyable. Eg. int, float, double etc.
+		 * @tparam INLINE_SIZE = Max No. of elements stored inline
 		 */
-		// BIG MATRIX Multiplication and Transpose
-		template<typename Data1>
-		class BigMatrix
+		template<typename T, size_t INLINE_SIZE=16>
+		class DynMatrix
 		{
-			int LEAF_SIZE; // Private variable LEAF_SIZE 
-			/**
-			 * \privatesection
-			 */
-			private:
+			// The heap buffer is raw aligned_alloc storage that is filled and copied without constructors or destructors.
+			static_assert(std::is_trivially_copyable<T>::value,"DynMatrix needs a trivially copyable DataType (Eg. int, float, double)");
 
-			/**
-			 * @brief Function to dynamically allocate/initialize an n x n matrix in the memory.
-			 * @param n = No. of rows and cols of the BigMatrix.
-			 * @return Returns a pointer pointing to a memory location containing 0 matrix of size n x n.
-			 *
-			 */
+			size_t n_rows;
+			size_t n_cols;
+			T* elements;              // Points to local or to the heap buffer
+			alignas(64) T local[INLINE_SIZE];
 
-			Data1** Init_matrix(int n)
-			{   // Calloc chunk of Memory
+			static const size_t ALIGNMENT=64;
+
+			bool is_inline() const
+			{
+				return elements==local;
+			}
 
-				Data1** M;
-				M=(Data1 **)calloc(n,sizeof(Data1*)); 
-				for(int i=0;i<n;i++)
+			void allocate(size_t rows, size_t cols)
+			{
+				if(cols!=0 && rows>(SIZE_MAX-ALIGNMENT)/sizeof(T)/cols) // rows x cols elements, rounded up to the alignment, must fit a size_t
 				{
-					M[i]=(Data1*)calloc(n,sizeof(Data1));
+					throw std::length_error("DynMatrix dimensions are too large");
 				}
-				return M;
+				n_rows=rows;
+				n_cols=cols;
+				size_t n=rows*cols;
+				if(n<=INLINE_SIZE)
+				{
+					elements=local;
+				}
+				else
+				{
+					size_t bytes=(n*sizeof(T)+ALIGNMENT-1)/ALIGNMENT*ALIGNMENT; // aligned_alloc needs a multiple of the alignment
+					elements=(T*)std::aligned_alloc(ALIGNMENT,bytes);
+					if(elements==NULL)
+					{
+						throw std::bad_alloc();
+					}
+				}
+				std::fill(elements,elements+n,T(0));
+			}
+
+			void release()
+			{
+				if(!is_inline())
+				{
+					std::free(elements);
+				}
+				elements=local;
+				n_rows=0;
+				n_cols=0;
+			}
+
+			void take(DynMatrix &other)
+			{
+				n_rows=other.n_rows;
+				n_cols=other.n_cols;
+				if(other.is_inline())
+				{
+					elements=local;
+					std::copy(other.local,other.local+n_rows*n_cols,local);
+				}
+				else
+				{
+					elements=other.elements; // Steal the heap buffer
+				}
+				other.elements=other.local;
+				other.n_rows=0;
+				other.n_cols=0;
 			}
 
+			public:
+
 			/**
-			 * @brief Function to Add 2 square Matrices of size n.
-			 * @param M1 = Pointer pointing to BigMatrix M1 loaded into memory  
-			 * @param M2 = Pointer pointing to BigMatrix M2 loaded into memory 
-			 * @param n  = Size of the Matrices
-			 * @return Returns a pointer pointing to a memory location containing the sum of M1 and M2
+			 * @brief Constructs a rows x cols Matrix of zeros.
 			 */
-			// Matrix ADD ===================
-			Data1** add(Data1** M1, Data1** M2, int n)
+			DynMatrix(size_t rows=0, size_t cols=0)
 			{
-				Data1** temp = Init_matrix(n);
-			    for(int i=0; i<n; i++)
-			        for(int j=0; j<n; j++)
-			            temp[i][j] = M1[i][j] + M2[i][j];
-			    return temp;
+				allocate(rows,cols);
 			}
 
 			/**
-			 * @brief Function to Subtract 2 square Matrices of size n.
-			 * @param M1 = Pointer pointing to BigMatrix M1 loaded into memory 
-			 * @param M2 = Pointer pointing to BigMatrix M2 loaded into memory 
-			 * @param n  = Size of the Matrices
-			 * @return Returns a pointer pointing to a memory location containing the difference of M1 and M2
+			 * @brief Overloaded constructor to initialize the Matrix from a 2D Initializer list. Eg: {{1,2},{3,4}}
 			 */
-			// Matrix SUBTRACT ===============
-			Data1** sub(Data1** M1, Data1** M2, int n)
+			DynMatrix(std::initializer_list<std::initializer_list<T>> my_list)
 			{
-				Data1** temp = Init_matrix(n);
-				for(int i=0; i<n; i++)
-					for(int j=0; j<n; j++)
-						temp[i][j] = M1[i][j] - M2[i][j];
-				return temp;
+				allocate(my_list.size(),my_list.size()? my_list.begin()->size() : 0);
+				size_t i=0;
+				for(std::initializer_list<T> row: my_list)
+				{
+					if(row.size()!=n_cols)
+					{
+						release();
+						throw std::invalid_argument("Wrong Matrix dimension initialized");
+					}
+					std::copy(row.begin(),row.end(),elements+i*n_cols);
+					i++;
+				}
 			}
 
 			/**
-			 * @brief The main Strassen's Algorithm function implemented using recursion. Takes in square Matrices A and B.
-			 * @param A = BigMatrix A
-			 * @param B = BigMatrix B
-			 * @param n = Size of both A and B
-			 * @return Returns a square matrix i.e. the Multiplication result of A and B.
-			 * 
-			 * The LEAF_SIZE is set by the MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function from witin the MATOPS::BigMatrix<Data1>::matmul() function. The input Matrices 
-			 * A and B are both broken down into 4 blocks, these matrices are used to calculate the 7 Strassen's coeffcient matrices. In order to calculate the Strassen's Coefficent
-			 * the StrassenMultiply function is recurssively called. Once the matrix sizes becomes equal to or less than LEAF_SIZE, we hit the base condition and perform the Matrix 
-			 * multiplication using the O(n^3) solution. Finally all the callocated memory (allocated by Init_matrix()) is freed up.
-			 * 
-			 * 
+			 * @brief Constructs a DynMatrix from a class Matrix of the same DataType.
 			 */
-			Data1** StrassenMultiply(Data1** A, Data1** B, int n)
-			{   
-				/* Naive Strassan's Algorithm (more time consuming)
-				  if(n==1)
+			template<size_t m, size_t n>
+			explicit DynMatrix(const Matrix<T,m,n> &M)
+			{
+				allocate(m,n);
+				for(size_t i=0;i<m;i++)
 				{
-					Data1** C=Init_matrix(1);
-					C[0][0]=A[0][0]*B[0][0];
-					return C;
-				}*/
+					for(size_t j=0;j<n;j++)
+					{
+						elements[i*n+j]=M.ElementAt(i,j);
+					}
+				}
+			}
 
-				// Once array size of LEAF_SIZE x LEAF_SIZE or lesser is reached we switch to the O(n^3) Matrix Multiplication solution, since after this 
-				// stage the recursion calls become a burden to the whole algorithm and we end up getting high execution time. The LEAF_SIZE is set by the
-				// MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function from witin the MATOPS::BigMatrix<Data1>::matmul() function.
-				if(n<=LEAF_SIZE)
+			/**
+			 * @brief Constructs a DynMatrix from a 2D vector, the in-memory format used by class BigMatrix (Eg. MATOPS::BigMatrix<Data1>::load_CSV).
+			 */
+			explicit DynMatrix(const std::vector<std::vector<T>> &MAT)
+			{
+				allocate(MAT.size(),MAT.empty()? 0 : MAT[0].size());
+				for(size_t i=0;i<n_rows;i++)
 				{
-					Data1** C=Init_matrix(n);
-					for(int i=0;i<n;i++)
+					if(MAT[i].size()!=n_cols)
 					{
-						for(int j=0;j<n;j++)
-						{
-							for(int k=0;k<n;k++)
-							{
-								C[i][j]+=A[i][k]*B[k][j];
-							}
-						}
+						release();
+						throw std::invalid_argument("Wrong Matrix dimension initialized");
 					}
-					return C;
+					std::copy(MAT[i].begin(),MAT[i].end(),elements+i*n_cols);
 				}
+			}
 
-				Data1** C = Init_matrix(n); // Initialize an nxn matrix to store 
-				int k = n/2;
+			DynMatrix(const DynMatrix&) = delete;
+			DynMatrix& operator=(const DynMatrix&) = delete;
 
-				// Initialize the Block Matrices
-				Data1** A11 = Init_matrix(k);
-				Data1** A12 = Init_matrix(k);
-				Data1** A21 = Init_matrix(k);
-				Data1** A22 = Init_matrix(k);
-				Data1** B11 = Init_matrix(k);
-				Data1** B12 = Init_matrix(k);
-				Data1** B21 = Init_matrix(k);
-				Data1** B22 = Init_matrix(k);
+			/**
+			 * @brief Move constructor, takes over the heap buffer of other (other is left empty).
+			 */
+			DynMatrix(DynMatrix &&other) noexcept
+			{
+				take(other);
+			}
 
-				// Build the block Matrices
-				for(int i=0;i<k;i++)
+			/**
+			 * @brief Move assignment, takes over the heap buffer of other (other is left empty).
+			 */
+			DynMatrix& operator=(DynMatrix &&other) noexcept
+			{
+				if(this!=&other)
 				{
-					for(int j=0;j<k;j++)
-					{
-						A11[i][j] = A[i][j];
-						A12[i][j] = A[i][k+j];
-						A21[i][j] = A[k+i][j];
-						A22[i][j] = A[k+i][k+j];
-						B11[i][j] = B[i][j];
-						B12[i][j] = B[i][k+j];
-						B21[i][j] = B[k+i][j];
-						B22[i][j] = B[k+i][k+j];
-					}
+					release();
+					take(other);
 				}
-				// Determine the Strassen's Coefficients
-				Data1** TEMP_B12_B22 = sub(B12, B22, k);
-				Data1** TEMP_A11_A12 = add(A11, A12, k);
-				Data1** TEMP_A21_A22 = add(A21, A22, k);
-				Data1** TEMP_B21_B11 = sub(B21, B11, k);
+				return *this;
+			}
 
+			/**
+			 * Destructor
+			 */
+			~DynMatrix()
+			{
+				release();
+			}
 
-				Data1** P1 = StrassenMultiply(A11, TEMP_B12_B22, k);
-				Data1** P2 = StrassenMultiply(TEMP_A11_A12, B22, k);
-				Data1** P3 = StrassenMultiply(TEMP_A21_A22, B11, k);
-				Data1** P4 = StrassenMultiply(A22, TEMP_B21_B11, k);
+			/**
+			 * @return Returns a deep copy of the Matrix.
+			 */
+			DynMatrix clone() const
+			{
+				DynMatrix copy(n_rows,n_cols);
+				std::copy(elements,elements+n_rows*n_cols,copy.elements);
+				return copy;
+			}
 
-				Data1** TEMP_A11_A22 = add(A11, A22, k);
-				Data1** TEMP_B11_B22 = add(B11, B22, k);
-				Data1** TEMP_A12_A22 = sub(A12, A22, k);
-				Data1** TEMP_B21_B22 = add(B21, B22, k);
-				Data1** TEMP_A11_A21 = sub(A11, A21, k);
-				Data1** TEMP_B11_B12 = add(B11, B12, k);
+			/**
+			 * @return Returns the number of Rows in the Matrix.
+			 */
+			size_t rows() const
+			{
+				return n_rows;
+			}
 
-				Data1** P5 = StrassenMultiply(TEMP_A11_A22, TEMP_B11_B22, k);
-				Data1** P6 = StrassenMultiply(TEMP_A12_A22, TEMP_B21_B22, k);
-				Data1** P7 = StrassenMultiply(TEMP_A11_A21, TEMP_B11_B12, k);
+			/**
+			 * @return Returns the number of columns in the Matrix
+			 */
+			size_t cols() const
+			{
+				return n_cols;
+			}
 
-				Data1** TEMP_P5_P4 = add(P5, P4, k);
-				Data1** TEMP_P5_P4_P6 = add(TEMP_P5_P4, P6, k);
-				Data1** TEMP_P5_P1 = add(P5, P1, k);
-				Data1** TEMP_P5_P1_P3 = sub(TEMP_P5_P1, P3, k);
+			/**
+			 * @return Returns a pointer to the row major elements.
+			 */
+			T* data()
+			{
+				return elements;
+			}
 
+			/**
+			 * @return Returns a pointer to the row major elements.
+			 */
+			const T* data() const
+			{
+				return elements;
+			}
 
-				Data1** C11 = sub(TEMP_P5_P4_P6, P2, k);
-				Data1** C12 = add(P1, P2, k);
-				Data1** C21 = add(P3, P4, k);
-				Data1** C22 = sub(TEMP_P5_P1_P3, P7, k);
+			/**
+			 * @brief Function to read value from the (i,j)th position of the Matrix
+			 */
+			const T& ElementAt(size_t i, size_t j) const
+				{ return elements[i*n_cols+j]; }
 
-				// Building the returning C Matrix
+			/**
+			 * @brief Function to write value to the (i,j)th position of the Matrix
+			 */
+			T& ElementAt(size_t i, size_t j)
+				{ return elements[i*n_cols+j]; }
 
-				for(int i=0; i<k; i++)
+			/**
+			 * @brief Converts the Matrix into a class Matrix of the given size. Throws std::invalid_argument if the dimensions don't match.
+			 */
+			template<size_t m, size_t n>
+			Matrix<T,m,n> to_matrix() const
+			{
+				if(m!=n_rows || n!=n_cols)
+				{
+					throw std::invalid_argument("Wrong Matrix dimension initialized");
+				}
+				Matrix<T,m,n> M;
+				for(size_t i=0;i<m;i++)
 				{
-					for(int j=0; j<k; j++)
+					for(size_t j=0;j<n;j++)
 					{
-						C[i][j] = C11[i][j];
-						C[i][j+k] = C12[i][j];
-						C[k+i][j] = C21[i][j];
-						C[k+i][k+j] = C22[i][j];
+						M.ElementAt(i,j)=elements[i*n+j];
 					}
 				}
+				return M;
+			}
 
-				// Free up all calloced memory.
-				for(int i=0; i<k; i++) {
-						free(TEMP_B12_B22[i]);
-						free(TEMP_A11_A12[i]);
-						free(TEMP_A21_A22[i]);
-						free(TEMP_B21_B11[i]);
-
-						free(TEMP_A11_A22[i]);
-						free(TEMP_B11_B22[i]);
-						free(TEMP_A12_A22[i]);
-						free(TEMP_B21_B22[i]);
-						free(TEMP_A11_A21[i]);
-						free(TEMP_B11_B12[i]);
-
-						free(TEMP_P5_P4[i]);
-						free(TEMP_P5_P4_P6[i]);
-						free(TEMP_P5_P1[i]);
-						free(TEMP_P5_P1_P3[i]);
-
-				        free(A11[i]);
-				        free(A12[i]);
-				        free(A21[i]);
-				        free(A22[i]);
-				        free(B11[i]);
-				        free(B12[i]);
-				        free(B21[i]);
-				        free(B22[i]);
-				        free(P1[i]);
-				        free(P2[i]);
-				        free(P3[i]);
-				        free(P4[i]);
-				        free(P5[i]);
-				        free(P6[i]);
-				        free(P7[i]);
-				        free(C11[i]);
-				        free(C12[i]);
-				        free(C21[i]);
-				        free(C22[i]);
-				    }
-
-					free(TEMP_B12_B22);
-					free(TEMP_A11_A12);
-					free(TEMP_A21_A22);
-					free(TEMP_B21_B11);
-
-					free(TEMP_A11_A22);
-					free(TEMP_B11_B22);
-					free(TEMP_A12_A22);
-					free(TEMP_B21_B22);
-					free(TEMP_A11_A21);
-					free(TEMP_B11_B12);
-
-					free(TEMP_P5_P4);
-					free(TEMP_P5_P4_P6);
-					free(TEMP_P5_P1);
-					free(TEMP_P5_P1_P3);
-
-					free(A11);
-				    free(A12);
-				    free(A21);
-				    free(A22);
-				    free(B11);
-				    free(B12);
-				    free(B21);
-				    free(B22);
-				    free(P1);
-				    free(P2);
-				    free(P3);
-				    free(P4);
-				    free(P5);
-				    free(P6);
-				    free(P7);
-				    free(C11);
-				    free(C12);
-				    free(C21);
-				    free(C22);
-
-				    return C;
+			/**
+			 * @brief Converts the Matrix into a 2D vector, the in-memory format used by class BigMatrix.
+			 */
+			std::vector<std::vector<T>> to_vector() const
+			{
+				std::vector<std::vector<T>> MAT(n_rows);
+				for(size_t i=0;i<n_rows;i++)
+				{
+					MAT[i].assign(elements+i*n_cols,elements+(i+1)*n_cols);
+				}
+				return MAT;
 			}
 
-			// Print Matrix (internal printing)
 			/**
-			 * @brief This function is called from within the MATOPS::BigMatrix<Data1>::matmul function when print == True
-			 * @param C Pointer to the memory where the array is stored.
-			 * @param m No of rows of the Matrix
-			 * @param n No of Columns of the Matrix
+			 * @brief Transpose of the Matrix. The copy is done in 32 x 32 tiles so that both the rows read and the rows written stay in the cache.
 			 */
-			void print_Mat(Data1** C, int m, int n)
+			DynMatrix transpose() const
 			{
-				for(int i=0;i<m;i++)
+				DynMatrix result(n_cols,n_rows);
+				const size_t TILE=32;
+				for(size_t ii=0;ii<n_rows;ii+=TILE)
 				{
-					for(int j=0;j<n;j++)
+					for(size_t jj=0;jj<n_cols;jj+=TILE)
 					{
-						std::cout<<C[i][j]<<" ";
+						size_t i_end=std::min(n_rows,ii+TILE), j_end=std::min(n_cols,jj+TILE);
+						for(size_t i=ii;i<i_end;i++)
+						{
+							for(size_t j=jj;j<j_end;j++)
+							{
+								result.elements[j*n_rows+i]=elements[i*n_cols+j];
+							}
+						}
 					}
-					std::cout<<'\n';
 				}
+				return result;
 			}
 
-		// LOAD from CSV file Template
 			/**
-			 * @brief Function to load CSV file. This function is internally called by  MATOPS::BigMatrix<Data1>::matmul  and  MATOPS::BigMatrix< Data1 >::Transpose 
-			 * to load the BigMatrix's to be multiplied or Transposed. It throws an error if path is invalid or CSV doesn't exist.
-			 * @param path= "path to CSV file i.e. to be loaded"
-			 * @return A pointer to the Matrix loaded in memory.
+			 * @brief Matrix multiplication. The product is computed in blocks of 64 rows of B (k) at a time with the i-k-j loop order: the inner loop runs
+			 * over contiguous rows of B and C and the block of B stays in the cache while all rows of A use it.
+			 * Throws std::invalid_argument if the inner dimensions don't match.
 			 */
-		std::vector<std::vector<Data1>> load_CSV(const std::string &path)
-		{
+			friend DynMatrix operator*(const DynMatrix &A, const DynMatrix &B)
+			{
+				if(A.n_cols!=B.n_rows)
+				{
+					throw std::invalid_argument("Matrix Inner Dimensions don't match can't multiply!!!");
+				}
+				DynMatrix C(A.n_rows,B.n_cols);
+				const size_t K_BLOCK=64;
+				const size_t n=B.n_cols;
+				for(size_t kk=0;kk<A.n_cols;kk+=K_BLOCK)
+				{
+					size_t k_end=std::min(A.n_cols,kk+K_BLOCK);
+					for(size_t i=0;i<A.n_rows;i++)
+					{
+						T* c=C.elements+i*n;
+						for(size_t k=kk;k<k_end;k++)
+						{
+							const T a=A.elements[i*A.n_cols+k];
+							const T* b=B.elements+k*n;
+							for(size_t j=0;j<n;j++)
+							{
+								c[j]+=a*b[j];
+							}
+						}
+					}
+				}
+				return C;
+			}
+
+			/**
+			 * @brief Operator overloaded to output/print an object of type DynMatrix.
+			 */
+			friend std::ostream& operator<<(std::ostream& os, const DynMatrix& rhs)
+			{
+				for(size_t i=0;i<rhs.n_rows;i++)
+				{
+					for(size_t j=0;j<rhs.n_cols;j++)
+						{os<<rhs.ElementAt(i,j)<<" ";}
+					os<<'\n';
+				}
+				return os;
+			}
+		};
+//=====================================================================================================================================
+
+		// CSV File storing
+		/**
+		 * @brief Function template to Store csv file at a given destination file. This function is internally called by matmul and Transpose 
+		 * function (with Data2:= int, float etc) to store the Resultant BigMatrix from the memory to a CSV file.
+		 * @tparam Data2
+		 * @param C = A Pointer pointing to the 2D BigMatrix in the memory
+		 * @param m_1 = No. of Rows of the Resultant BigMatrix
+		 * @param n_2 = No. of Columns of the Resultant BigMatrix
+		 * @param path = "path to destination csv file"
+		 * @return Returns false if the destination file could not be opened or written.
+		 */
+		template<typename Data2>
+				bool store_csv(Data2 ** C, size_t m_1, size_t n_2, std::string path)
+					{
+						std::ofstream file;
+						file.open(path);
+						if(file.fail()) // Let the caller decide how to report an unwritable destination.
+						{
+							return false;
+						}
+
+						for(size_t i=0;i<m_1;i++)
+						{
+							for(size_t j=0;j<n_2;j++)
+							{
+								file<<C[i][j];
+								if(j+1<n_2)
+								{
+									file<<",";
+								}
+								else
+								{
+									file<<"\n";
+								}
+							}
+						}
+						file.close();
+						return !file.fail();
+					}
+
+		/**
+		 * @brief Overload of store_csv for a Matrix held in a 2D vector (the in-memory format returned by MATOPS::BigMatrix<Data1>::load_CSV).
+		 * @tparam Data2
+		 * @param C = 2D vector holding the Matrix
+		 * @param path = "path to destination csv file"
+		 * @return Returns false if the destination file could not be opened or written.
+		 */
+		template<typename Data2>
+				bool store_csv(const std::vector<std::vector<Data2>> &C, std::string path)
+					{
+						std::ofstream file;
+						file.open(path);
+						if(file.fail())
+						{
+							return false;
+						}
+
+						for(const std::vector<Data2> &row: C)
+						{
+							for(size_t j=0;j<row.size();j++)
+							{
+								file<<row[j];
+								file<<((j+1<row.size())? ",":"\n");
+							}
+						}
+						file.close();
+						return !file.fail();
+					}
+
+		// Template to convert variable type from string to int,float, double or any other Datatype
+		/**
+		 * @brief Function template to convert variable type from string to int,float, double or any other Datatype spcified by My_data.
+		 * @tparam My_data = Datatype into which we want to convert the string inputs parsed from CSV files.
+		 * @param str = String input from the Csv file.
+		 * @return Returns Converted number from string to My_data.
+		 */
+		template<typename My_data> My_data convert_to(const std::string &str)
+			{
+				std::istringstream ss(str); 
+
+				My_data num;
+
+				ss>>num;
+				return num;
+			}
+
+		/**
+		 * @brief Parse a complex csv cell "a+bi" into its real and imaginary parts. Accepted forms are "a", "bi", "a+bi", "a-bi", "i", "-i" and "a+i"
+		 * (j may be used instead of i), with any real number syntax for a and b (Eg. "1.5e-3-2i").
+		 * @tparam T = Real Datatype of the parts
+		 * @param cell = Cell of the csv file
+		 * @param re = Returns the real part
+		 * @param im = Returns the imaginary part
+		 *
+		 * Throws std::runtime_error if the cell is not a complex number.
+		 */
+		template<typename T>
+		void parse_complex(const std::string &cell, T &re, T &im)
+		{
+			const char* p=cell.c_str();
+			while(*p==' ' || *p=='\t')
+			{
+				p++;
+			}
+			// A number, or a bare sign (coefficient 1) when it is directly followed by the imaginary unit.
+			auto number=[](const char* s, const char** end, double &x){
+				char* stop;
+				x=std::strtod(s,&stop);
+				if(stop!=s)
+				{
+					*end=stop;
+					return true;
+				}
+				const char* t=s;
+				x= (*t=='-')? -1 : 1;
+				if(*t=='+' || *t=='-')
+				{
+					t++;
+				}
+				*end=t;
+				return *t=='i' || *t=='j';
+			};
+			auto is_unit=[](char c){ return c=='i' || c=='j'; };
+			auto at_end=[](const char* s){
+				while(*s==' ' || *s=='\t' || *s=='\r')
+				{
+					s++;
+				}
+				return *s=='\0';
+			};
+
+			const char* end;
+			double a, b;
+			bool valid=number(p,&end,a);
+			re=T(0);
+			im=T(0);
+			if(valid && is_unit(*end)) // "bi"
+			{
+				im=T(a);
+				valid=at_end(end+1);
+			}
+			else if(valid && (*end=='+' || *end=='-')) // "a+bi"
+			{
+				const char* end_2;
+				valid=number(end,&end_2,b) && is_unit(*end_2) && at_end(end_2+1);
+				re=T(a);
+				im=T(b);
+			}
+			else if(valid) // "a"
+			{
+				re=T(a);
+				valid=at_end(end);
+			}
+			if(!valid)
+			{
+				throw std::runtime_error("Invalid complex value '"+cell+"'");
+			}
+		}
+
+		/**
+		 * @brief Format a complex number as a csv cell "a+bi" (see MATOPS::parse_complex).
+		 */
+		template<typename T>
+		std::string format_complex(T re, T im)
+		{
+			std::ostringstream cell;
+			cell<<re<<((im<T(0) || (im==T(0) && std::signbit(im)))? "-" : "+")<<std::fabs(im)<<"i";
+			return cell.str();
+		}
+
+		// Thread pool shared by the batch and parallel code paths
+		/**
+		 * @brief A fixed size pool of worker threads. Tasks are queued with submit() and executed in FIFO order by the first free worker.
+		 * The pool is shared by all jobs of a MATOPS::BigMatrix<Data1>::matmul_batch() call so that no job has to spawn threads of its own.
+		 * There is no work stealing from the queue: a task that needs the results of other work must use MATOPS::parallel_for, which lets the
+		 * waiting thread run only the chunks of its own loop, and must not block on a task it queued with submit().
+		 */
+		class ThreadPool
+		{
+			std::vector<std::thread> workers;
+			std::queue<std::function<void()>> tasks;
+			std::mutex queue_mutex;
+			std::condition_variable condition;
+			bool stop;
+
+			public:
+
+			/**
+			 * @brief Starts the worker threads.
+			 * @param n_threads = No. of worker threads. 0 picks the number of hardware threads.
+			 */
+			explicit ThreadPool(size_t n_threads=0):stop(false)
+			{
+				if(n_threads==0)
+				{
+					n_threads=std::max<size_t>(1,std::thread::hardware_concurrency());
+				}
+				for(size_t i=0;i<n_threads;i++)
+				{
+					workers.emplace_back([this]{
+						while(true)
+						{
+							std::function<void()> task;
+							{
+								std::unique_lock<std::mutex> lock(queue_mutex);
+								condition.wait(lock,[this]{ return stop || !tasks.empty(); });
+								if(stop && tasks.empty())
+								{
+									return;
+								}
+								task=std::move(tasks.front());
+								tasks.pop();
+							}
+							task();
+						}
+					});
+				}
+			}
+
+			ThreadPool(const ThreadPool&) = delete;
+			ThreadPool& operator=(const ThreadPool&) = delete;
+
+			/**
+			 * Destructor: finishes all queued tasks and joins the workers.
+			 */
+			~ThreadPool()
+			{
+				{
+					std::unique_lock<std::mutex> lock(queue_mutex);
+					stop=true;
+				}
+				condition.notify_all();
+				for(std::thread &worker: workers)
+				{
+					worker.join();
+				}
+			}
+
+			/**
+			 * @return Returns the number of worker threads in the pool.
+			 */
+			size_t size() const
+			{
+				return workers.size();
+			}
+
+			/**
+			 * @brief Queue a task for execution.
+			 * @param f = Callable taking no arguments.
+			 * @return A future holding the return value (or the exception) of f.
+			 */
+			template<typename F>
+			auto submit(F f) -> std::future<decltype(f())>
+			{
+				typedef decltype(f()) Ret;
+				std::shared_ptr<std::packaged_task<Ret()>> task=std::make_shared<std::packaged_task<Ret()>>(std::move(f));
+				std::future<Ret> result=task->get_future();
+				{
+					std::unique_lock<std::mutex> lock(queue_mutex);
+					tasks.emplace([task]{ (*task)(); });
+				}
+				condition.notify_one();
+				return result;
+			}
+
+		};
+
+		/**
+		 * @brief Split the index range [begin,end) into chunks, run f(chunk_begin,chunk_end) for every chunk on the pool and wait for all of them.
+		 * The chunks are claimed from a counter owned by this call: the calling thread claims chunks itself and up to pool.size() helper tasks
+		 * claim the rest. While it waits the caller only ever runs chunks of its own loop, never other queued tasks, so it may be called from a task
+		 * running on the same pool (nested parallelism) even when that task holds a lock or a MATOPS::MemoryBudget reservation. If every worker
+		 * is busy the caller simply runs all the chunks itself.
+		 *
+		 * Restriction: f must not wait for anything that only a later task on the pool can provide (Eg. a future of a task submitted after it),
+		 * since the queued helpers of this call may not get a worker before f returns.
+		 * @param pool = Pool to run the chunks on
+		 * @param begin = First index
+		 * @param end = One past the last index
+		 * @param f = Callable taking (size_t chunk_begin, size_t chunk_end). If a chunk throws, the first exception is rethrown once every chunk is done.
+		 */
+		template<typename F>
+		void parallel_for(ThreadPool &pool, size_t begin, size_t end, F f)
+		{
+			if(end<=begin)
+			{
+				return;
+			}
+			struct Loop
+			{
+				std::atomic<size_t> next;
+				size_t n_chunks, chunk, begin, end;
+				size_t done;
+				std::exception_ptr error;
+				std::mutex loop_mutex;
+				std::condition_variable finished;
+				F* f;
+			};
+			std::shared_ptr<Loop> loop=std::make_shared<Loop>();
+			loop->next=0;
+			loop->n_chunks=std::min(end-begin,4*pool.size()); // A few chunks per worker to even out uneven rows.
+			loop->chunk=(end-begin+loop->n_chunks-1)/loop->n_chunks;
+			loop->n_chunks=(end-begin+loop->chunk-1)/loop->chunk;
+			loop->begin=begin;
+			loop->end=end;
+			loop->done=0;
+			loop->f=&f;
+
+			// Claim and run chunks until none are left. f is only touched after a chunk was claimed, so a helper that starts after the loop is
+			// over returns without using it.
+			auto run_chunks=[](const std::shared_ptr<Loop> &l){
+				size_t c;
+				while((c=l->next.fetch_add(1))<l->n_chunks)
+				{
+					size_t lo=l->begin+c*l->chunk;
+					size_t hi=std::min(l->end,lo+l->chunk);
+					std::exception_ptr error;
+					try{
+						(*l->f)(lo,hi);
+					}catch (...)
+					{
+						error=std::current_exception();
+					}
+					std::lock_guard<std::mutex> lock(l->loop_mutex);
+					if(error && !l->error)
+					{
+						l->error=error;
+					}
+					if(++l->done==l->n_chunks)
+					{
+						l->finished.notify_all();
+					}
+				}
+			};
+
+			size_t n_helpers=std::min(loop->n_chunks-1,pool.size());
+			for(size_t h=0;h<n_helpers;h++)
+			{
+				pool.submit([loop,run_chunks]{ run_chunks(loop); });
+			}
+			run_chunks(loop);
+			std::unique_lock<std::mutex> lock(loop->loop_mutex);
+			loop->finished.wait(lock,[&loop]{ return loop->done==loop->n_chunks; });
+			if(loop->error)
+			{
+				std::rethrow_exception(loop->error);
+			}
+		}
+
+		/**
+		 * @brief Counting semaphore over a number of bytes. A batch job reserves its estimated working set before it starts and gives it back
+		 * once it is done, so that the jobs running at the same time never exceed the global memory budget.
+		 */
+		class MemoryBudget
+		{
+			size_t capacity;
+			size_t available;
+			std::mutex budget_mutex;
+			std::condition_variable released;
+
+			public:
+
+			/**
+			 * @param bytes = Total budget in bytes. 0 means unlimited.
+			 */
+			explicit MemoryBudget(size_t bytes=0):capacity(bytes),available(bytes) {}
+
+			/**
+			 * @brief Block until bytes are available and reserve them. A request larger than the whole budget is clamped to the budget, i.e. it
+			 * runs alone instead of never running at all.
+			 * @return The number of bytes actually reserved, to be passed back to release().
+			 */
+			size_t acquire(size_t bytes)
+			{
+				if(capacity==0)
+				{
+					return 0;
+				}
+				bytes=std::min(bytes,capacity);
+				std::unique_lock<std::mutex> lock(budget_mutex);
+				released.wait(lock,[this,bytes]{ return available>=bytes; });
+				available-=bytes;
+				return bytes;
+			}
+
+			/**
+			 * @brief Give back bytes reserved by acquire().
+			 */
+			void release(size_t bytes)
+			{
+				if(capacity==0)
+				{
+					return;
+				}
+				{
+					std::unique_lock<std::mutex> lock(budget_mutex);
+					available+=bytes;
+				}
+				released.notify_all();
+			}
+		};
+
+		/**
+		 * @brief Size of a huge page. Blocks of at least this size are allocated by MATOPS::huge_alloc with mmap and backed by huge pages.
+		 */
+		const size_t HUGE_PAGE_SIZE=size_t(2)<<20;
+
+		/**
+		 * @brief Allocate a zeroed block of memory for a large Matrix. Blocks of at least HUGE_PAGE_SIZE bytes are mapped on Linux, first from explicit
+		 * huge pages (hugetlbfs, only succeeds when pages were reserved through /proc/sys/vm/nr_hugepages) and otherwise as normal pages marked with
+		 * madvise(MADV_HUGEPAGE) for transparent huge pages, so a multi-GB operand costs one TLB entry per 2MB instead of per 4KB. Smaller blocks and other
+		 * systems use calloc. The block must be released with MATOPS::huge_free.
+		 * @param bytes = Size of the block
+		 * @return Returns a 64 byte aligned pointer to the block.
+		 *
+		 * Throws std::bad_alloc if the memory can't be allocated.
+		 */
+		inline void* huge_alloc(size_t bytes)
+		{
+			// A 64 byte prefix remembers the size and the kind of the allocation for huge_free().
+			const size_t PREFIX=64;
+			enum Kind: size_t { CALLOC, MAPPED };
+			if(bytes>SIZE_MAX-PREFIX-HUGE_PAGE_SIZE) // The prefix and the rounding up to whole pages must not wrap around
+			{
+				throw std::bad_alloc();
+			}
+			size_t total=bytes+PREFIX;
+			char* base=NULL;
+			size_t kind=CALLOC;
+			#ifdef __linux__
+			if(total>=HUGE_PAGE_SIZE)
+			{
+				total=(total+HUGE_PAGE_SIZE-1)/HUGE_PAGE_SIZE*HUGE_PAGE_SIZE;
+				void* p=mmap(NULL,total,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS|MAP_HUGETLB,-1,0);
+				if(p==MAP_FAILED)
+				{
+					p=mmap(NULL,total,PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+					if(p!=MAP_FAILED)
+					{
+						madvise(p,total,MADV_HUGEPAGE);
+					}
+				}
+				if(p==MAP_FAILED)
+				{
+					throw std::bad_alloc();
+				}
+				base=(char*)p;
+				kind=MAPPED;
+			}
+			#endif
+			if(base==NULL)
+			{
+				base=(char*)std::aligned_alloc(PREFIX,(total+PREFIX-1)/PREFIX*PREFIX);
+				if(base==NULL)
+				{
+					throw std::bad_alloc();
+				}
+				memset(base,0,total);
+			}
+			((size_t*)base)[0]=total;
+			((size_t*)base)[1]=kind;
+			return base+PREFIX;
+		}
+
+		/**
+		 * @brief Release a block allocated by MATOPS::huge_alloc.
+		 */
+		inline void huge_free(void* block)
+		{
+			if(block==NULL)
+			{
+				return;
+			}
+			char* base=(char*)block-64;
+			size_t total=((size_t*)base)[0];
+			#ifdef __linux__
+			if(((size_t*)base)[1]!=0)
+			{
+				munmap(base,total);
+				return;
+			}
+			#endif
+			(void)total;
+			std::free(base);
+		}
+
+		/**
+		 * @brief One multiplication job of a MATOPS::BigMatrix<Data1>::matmul_batch() call, i.e. file_1 x file_2 is stored in path.
+		 */
+		struct MatmulJob
+		{
+			std::string file_1; ///< "path to A.csv"
+			std::string file_2; ///< "path to B.csv"
+			std::string path;   ///< path to store the result
+		};
+
+		/**
+		 * @brief Outcome of a batch job.
+		 */
+		enum class JobStatus
+		{
+			OK,                 ///< Result stored successfully
+			FILE_ERROR,         ///< An input could not be read or the output could not be written
+			DIMENSION_MISMATCH  ///< Inner dimensions of the operands don't match
+		};
+
+		/**
+		 * @brief Per job status and timing returned by MATOPS::BigMatrix<Data1>::matmul_batch(). All times are in seconds.
+		 */
+		struct JobResult
+		{
+			JobStatus status=JobStatus::OK;
+			std::string message;       ///< Error message if status != OK
+			double wait_time=0;        ///< Time spent waiting for the memory budget
+			double load_time=0;        ///< Time spent parsing (or waiting for a shared operand)
+			double compute_time=0;     ///< Time spent in the multiplication
+			double store_time=0;       ///< Time spent writing the result
+			double total_time=0;       ///< Time from job start to completion
+		};
+
+
+		/**
+		 * @brief Operand precision used by the quantized GEMM path of MATOPS::BigMatrix<Data1>::matmul.
+		 */
+		enum class Quantization
+		{
+			NONE,   ///< Multiply in Data1 (Strassen's Algorithm)
+			INT8,   ///< 8 bit operands, 32 bit accumulation
+			INT16   ///< 16 bit operands, 64 bit accumulation
+		};
+
+		/**
+		 * @brief A Matrix quantized to int8_t or int16_t with one float scale factor per row, i.e. value(i,j) ~ scales[i] * data[i*cols+j].
+		 * The right hand operand of a product is quantized per column and stored transposed (one row per column of B), so that both operands
+		 * of every dot product are contiguous in memory.
+		 * @tparam Q = int8_t or int16_t
+		 */
+		template<typename Q>
+		struct QuantizedMatrix
+		{
+			size_t rows=0;
+			size_t cols=0;
+			std::vector<Q> data;       // rows x cols, row major
+			std::vector<float> scales; // One scale per row
+
+			/**
+			 * @brief Symmetric per row quantization: the row is scaled so that its largest absolute value maps to the largest value of Q.
+			 * @param MAT = Matrix to quantize
+			 * @param transposed = Quantize the columns of MAT instead of its rows (the result holds MAT's transpose)
+			 */
+			template<typename T>
+			static QuantizedMatrix quantize(const std::vector<std::vector<T>> &MAT, bool transposed=false)
+			{
+				QuantizedMatrix q;
+				size_t m=MAT.size(), n=MAT.empty()? 0 : MAT[0].size();
+				q.rows=transposed? n : m;
+				q.cols=transposed? m : n;
+				q.data.resize(q.rows*q.cols);
+				q.scales.resize(q.rows);
+				const float q_max=(float)std::numeric_limits<Q>::max();
+				for(size_t i=0;i<q.rows;i++)
+				{
+					float max_abs=0;
+					for(size_t j=0;j<q.cols;j++)
+					{
+						float x=(float)(transposed? MAT[j][i] : MAT[i][j]);
+						max_abs=std::max(max_abs,std::fabs(x));
+					}
+					float scale=(max_abs>0)? max_abs/q_max : 1.0f;
+					q.scales[i]=scale;
+					for(size_t j=0;j<q.cols;j++)
+					{
+						float x=(float)(transposed? MAT[j][i] : MAT[i][j]);
+						q.data[i*q.cols+j]=(Q)std::max(-q_max,std::min(q_max,std::nearbyint(x/scale)));
+					}
+				}
+				return q;
+			}
+		};
+
+		/**
+		 * @brief Integer dot product of two int8_t vectors. The products are summed in 32 bit blocks of at most 2^16 elements (|127*127| * 2^16 < 2^31)
+		 * that are added up in 64 bit. With AVX2 the vectors are widened to 16 bit and multiplied with _mm256_madd_epi16.
+		 */
+		inline int64_t quantized_dot(const int8_t* a, const int8_t* b, size_t n)
+		{
+			int64_t total=0;
+			for(size_t start=0;start<n;start+=65536)
+			{
+				size_t end=std::min(n,start+65536);
+				size_t k=start;
+				int32_t block=0;
+				#ifdef __AVX2__
+				__m256i acc=_mm256_setzero_si256();
+				for(;k+16<=end;k+=16)
+				{
+					__m256i va=_mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(a+k)));
+					__m256i vb=_mm256_cvtepi8_epi16(_mm_loadu_si128((const __m128i*)(b+k)));
+					acc=_mm256_add_epi32(acc,_mm256_madd_epi16(va,vb));
+				}
+				int32_t lanes[8];
+				_mm256_storeu_si256((__m256i*)lanes,acc);
+				for(int l=0;l<8;l++)
+				{
+					block+=lanes[l];
+				}
+				#endif
+				for(;k<end;k++)
+				{
+					block+=(int32_t)a[k]*b[k];
+				}
+				total+=block;
+			}
+			return total;
+		}
+
+		/**
+		 * @brief Integer dot product of two int16_t vectors. Every _mm256_madd_epi16 pair sum fits in 32 bit (values are clamped to +-32767), the
+		 * pair sums are accumulated in 64 bit.
+		 */
+		inline int64_t quantized_dot(const int16_t* a, const int16_t* b, size_t n)
+		{
+			int64_t total=0;
+			size_t k=0;
+			#ifdef __AVX2__
+			__m256i acc=_mm256_setzero_si256();
+			for(;k+16<=n;k+=16)
+			{
+				__m256i prod=_mm256_madd_epi16(_mm256_loadu_si256((const __m256i*)(a+k)),_mm256_loadu_si256((const __m256i*)(b+k)));
+				acc=_mm256_add_epi64(acc,_mm256_cvtepi32_epi64(_mm256_castsi256_si128(prod)));
+				acc=_mm256_add_epi64(acc,_mm256_cvtepi32_epi64(_mm256_extracti128_si256(prod,1)));
+			}
+			int64_t lanes[4];
+			_mm256_storeu_si256((__m256i*)lanes,acc);
+			total=lanes[0]+lanes[1]+lanes[2]+lanes[3];
+			#endif
+			for(;k<n;k++)
+			{
+				total+=(int32_t)a[k]*b[k];
+			}
+			return total;
+		}
+
+		/**
+		 * @brief Quantized GEMM: C = dequantize(A_q x B_q). Rows of C are split between the workers of the pool.
+		 * @param A = Left operand quantized per row (m x k)
+		 * @param B_T = Right operand quantized per column, i.e. holding B's transpose (n x k)
+		 * @param pool = Pool to run on
+		 * @return The float result of size m x n, C[i][j] = A.scales[i] * B_T.scales[j] * dot(A row i, B column j).
+		 */
+		template<typename Q>
+		std::vector<std::vector<float>> quantized_gemm(const QuantizedMatrix<Q> &A, const QuantizedMatrix<Q> &B_T, ThreadPool &pool)
+		{
+			if(A.cols!=B_T.cols)
+			{
+				throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+			}
+			std::vector<std::vector<float>> C(A.rows,std::vector<float>(B_T.rows));
+			parallel_for(pool,0,A.rows,[&](size_t lo, size_t hi){
+				for(size_t i=lo;i<hi;i++)
+				{
+					const Q* a=A.data.data()+i*A.cols;
+					for(size_t j=0;j<B_T.rows;j++)
+					{
+						int64_t acc=quantized_dot(a,B_T.data.data()+j*B_T.cols,A.cols);
+						C[i][j]=(float)acc*A.scales[i]*B_T.scales[j];
+					}
+				}
+			});
+			return C;
+		}
+
+		/**
+		 * @brief Multiply two matrices held in 2D vectors through the quantized GEMM path.
+		 * @param MAT_1 = Matrix A (m x k)
+		 * @param MAT_2 = Matrix B (k x n)
+		 * @param mode = Quantization::INT8 or Quantization::INT16
+		 * @param pool = Pool to run on
+		 * @return The dequantized float result of size m x n.
+		 */
+		template<typename T>
+		std::vector<std::vector<float>> quantized_multiply(const std::vector<std::vector<T>> &MAT_1, const std::vector<std::vector<T>> &MAT_2, Quantization mode, ThreadPool &pool)
+		{
+			if(mode==Quantization::INT16)
+			{
+				return quantized_gemm(QuantizedMatrix<int16_t>::quantize(MAT_1),QuantizedMatrix<int16_t>::quantize(MAT_2,true),pool);
+			}
+			if(mode==Quantization::INT8)
+			{
+				return quantized_gemm(QuantizedMatrix<int8_t>::quantize(MAT_1),QuantizedMatrix<int8_t>::quantize(MAT_2,true),pool);
+			}
+			throw std::invalid_argument("quantized_multiply needs Quantization::INT8 or Quantization::INT16");
+		}
+
+		/**
+		 * @brief quantized_multiply on a temporary pool.
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		template<typename T>
+		std::vector<std::vector<float>> quantized_multiply(const std::vector<std::vector<T>> &MAT_1, const std::vector<std::vector<T>> &MAT_2, Quantization mode, size_t n_threads=0)
+		{
+			ThreadPool pool(n_threads);
+			return quantized_multiply(MAT_1,MAT_2,mode,pool);
+		}
+
+		/**
+		 * @brief Dot product of two contiguous vectors. Four independent accumulators break the dependency chain of the sum, so the loop is pipelined
+		 * instead of waiting for every add. The compiler only vectorizes it for integer types (or with -ffast-math), float and double have explicit
+		 * AVX2 overloads below.
+		 */
+		template<typename T>
+		inline T dot_product(const T* a, const T* b, size_t n)
+		{
+			T s0=T(0), s1=T(0), s2=T(0), s3=T(0);
+			size_t k=0;
+			for(;k+4<=n;k+=4)
+			{
+				s0+=a[k]*b[k];
+				s1+=a[k+1]*b[k+1];
+				s2+=a[k+2]*b[k+2];
+				s3+=a[k+3]*b[k+3];
+			}
+			for(;k<n;k++)
+			{
+				s0+=a[k]*b[k];
+			}
+			return (s0+s1)+(s2+s3);
+		}
+
+		/**
+		 * @brief Dot product of two float vectors. With AVX2 two 256 bit accumulators (16 independent partial sums) are used, otherwise the generic
+		 * MATOPS::dot_product runs.
+		 */
+		inline float dot_product(const float* a, const float* b, size_t n)
+		{
+			#ifdef __AVX2__
+			__m256 acc0=_mm256_setzero_ps(), acc1=_mm256_setzero_ps();
+			size_t k=0;
+			for(;k+16<=n;k+=16)
+			{
+				acc0=_mm256_add_ps(acc0,_mm256_mul_ps(_mm256_loadu_ps(a+k),_mm256_loadu_ps(b+k)));
+				acc1=_mm256_add_ps(acc1,_mm256_mul_ps(_mm256_loadu_ps(a+k+8),_mm256_loadu_ps(b+k+8)));
+			}
+			float lanes[8];
+			_mm256_storeu_ps(lanes,_mm256_add_ps(acc0,acc1));
+			float total=((lanes[0]+lanes[1])+(lanes[2]+lanes[3]))+((lanes[4]+lanes[5])+(lanes[6]+lanes[7]));
+			for(;k<n;k++)
+			{
+				total+=a[k]*b[k];
+			}
+			return total;
+			#else
+			return dot_product<float>(a,b,n);
+			#endif
+		}
+
+		/**
+		 * @brief Dot product of two double vectors. With AVX2 two 256 bit accumulators (8 independent partial sums) are used, otherwise the generic
+		 * MATOPS::dot_product runs.
+		 */
+		inline double dot_product(const double* a, const double* b, size_t n)
+		{
+			#ifdef __AVX2__
+			__m256d acc0=_mm256_setzero_pd(), acc1=_mm256_setzero_pd();
+			size_t k=0;
+			for(;k+8<=n;k+=8)
+			{
+				acc0=_mm256_add_pd(acc0,_mm256_mul_pd(_mm256_loadu_pd(a+k),_mm256_loadu_pd(b+k)));
+				acc1=_mm256_add_pd(acc1,_mm256_mul_pd(_mm256_loadu_pd(a+k+4),_mm256_loadu_pd(b+k+4)));
+			}
+			double lanes[4];
+			_mm256_storeu_pd(lanes,_mm256_add_pd(acc0,acc1));
+			double total=(lanes[0]+lanes[1])+(lanes[2]+lanes[3]);
+			for(;k<n;k++)
+			{
+				total+=a[k]*b[k];
+			}
+			return total;
+			#else
+			return dot_product<double>(a,b,n);
+			#endif
+		}
+
+		/**
+		 * @brief Compressed Sparse Row (CSR) Matrix for operands that are mostly zeros. Only the non zero values are stored: the values of row i and their
+		 * column indices are stored in values[row_ptr[i] .. row_ptr[i+1]) and col_idx[row_ptr[i] .. row_ptr[i+1]). The Matrix can be built straight from a
+		 * dense CSV file (zeros are skipped while parsing, the dense form is never created), from a sparse COO text file or from (row, col, value) triplets.
+		 *
+		 * The COO text file has the dimensions "rows,cols" in its first line followed by one "row,col,value" line (0 based indices) per non zero.
+		 * @tparam T = DataType of the Matrix. Eg. int, float, double etc.
+		 */
+		template<typename T>
+		class SparseMatrix
+		{
+			size_t n_rows;
+			size_t n_cols;
+			std::vector<size_t> row_ptr; // rows+1 offsets into col_idx and values
+			std::vector<size_t> col_idx;
+			std::vector<T> values;
+
+			public:
+
+			/**
+			 * @brief A (row, col, value) entry used to build a SparseMatrix in COO form.
+			 */
+			struct Triplet
+			{
+				size_t row;
+				size_t col;
+				T value;
+			};
+
+			/**
+			 * @brief Constructs an empty (all zero) rows x cols Matrix.
+			 */
+			SparseMatrix(size_t rows=0, size_t cols=0):n_rows(rows),n_cols(cols),row_ptr(rows+1,0) {}
+
+			/**
+			 * @return Returns the number of Rows in the Matrix.
+			 */
+			size_t rows() const
+			{
+				return n_rows;
+			}
+
+			/**
+			 * @return Returns the number of columns in the Matrix
+			 */
+			size_t cols() const
+			{
+				return n_cols;
+			}
+
+			/**
+			 * @return Returns the number of stored non zero values.
+			 */
+			size_t nnz() const
+			{
+				return values.size();
+			}
+
+			/**
+			 * @return Returns the fraction of non zero values, i.e. nnz / (rows x cols).
+			 */
+			double density() const
+			{
+				return (n_rows==0 || n_cols==0)? 0.0 : (double)nnz()/((double)n_rows*n_cols);
+			}
+
+			/**
+			 * @brief Build a CSR Matrix from COO triplets. The triplets don't have to be sorted, duplicated (row, col) entries are summed.
+			 * @param rows = No. of Rows
+			 * @param cols = No. of Columns
+			 * @param triplets = Non zero entries
+			 */
+			static SparseMatrix from_triplets(size_t rows, size_t cols, std::vector<Triplet> triplets)
+			{
+				SparseMatrix S(rows,cols);
+				std::sort(triplets.begin(),triplets.end(),[](const Triplet &a, const Triplet &b){
+					return (a.row<b.row) || (a.row==b.row && a.col<b.col);
+				});
+				for(size_t p=0;p<triplets.size();p++)
+				{
+					const Triplet &t=triplets[p];
+					if(t.row>=rows || t.col>=cols)
+					{
+						throw std::out_of_range("Triplet index outside of the Matrix dimensions");
+					}
+					if(p>0 && triplets[p-1].row==t.row && triplets[p-1].col==t.col)
+					{
+						S.values.back()+=t.value; // Duplicate entry
+						continue;
+					}
+					S.col_idx.push_back(t.col);
+					S.values.push_back(t.value);
+					S.row_ptr[t.row+1]++; // Count per row, turned into offsets below
+				}
+				for(size_t i=0;i<rows;i++)
+				{
+					S.row_ptr[i+1]+=S.row_ptr[i];
+				}
+				return S;
+			}
+
+			/**
+			 * @brief Build a CSR Matrix from a dense Matrix held in a 2D vector, dropping the zeros.
+			 * @param MAT = Dense Matrix
+			 */
+			static SparseMatrix from_dense(const std::vector<std::vector<T>> &MAT)
+			{
+				SparseMatrix S(MAT.size(),MAT.empty()? 0 : MAT[0].size());
+				for(size_t i=0;i<S.n_rows;i++)
+				{
+					for(size_t j=0;j<MAT[i].size();j++)
+					{
+						if(MAT[i][j]!=T(0))
+						{
+							S.col_idx.push_back(j);
+							S.values.push_back(MAT[i][j]);
+						}
+					}
+					S.row_ptr[i+1]=S.values.size();
+				}
+				return S;
+			}
+
+			/**
+			 * @brief Load a dense CSV file straight into CSR form. Zeros are dropped while parsing, so the dense Matrix is never created.
+			 * @param path = "path to A.csv"
+			 *
+			 * Throws std::runtime_error if the file doesn't exist.
+			 */
+			static SparseMatrix load_CSV(const std::string &path)
+			{
+				std::ifstream indata;
+				indata.open(path);
+				if(indata.fail())
+				{
+					throw std::runtime_error("File path: '"+path+"' doesn't exist");
+				}
+				SparseMatrix S;
+				S.row_ptr.assign(1,0);
+				std::string line="";
+				while(getline(indata,line))
+				{
+					if(line.empty() || line=="\r") // Blank lines are not rows
+					{
+						continue;
+					}
+					std::stringstream lineStream(line);
+					std::string cell;
+					size_t j=0;
+					while(std::getline(lineStream,cell,','))
+					{
+						T value=convert_to<T>(cell);
+						if(value!=T(0))
+						{
+							S.col_idx.push_back(j);
+							S.values.push_back(value);
+						}
+						j++;
+					}
+					S.n_cols=std::max(S.n_cols,j);
+					S.row_ptr.push_back(S.values.size());
+					S.n_rows++;
+				}
+				indata.close();
+				return S;
+			}
+
+			/**
+			 * @brief Load a sparse COO text file ("rows,cols" header followed by "row,col,value" lines).
+			 * @param path = "path to A.coo"
+			 *
+			 * Throws std::runtime_error if the file doesn't exist or is malformed.
+			 */
+			static SparseMatrix load_COO(const std::string &path)
+			{
+				std::ifstream indata;
+				indata.open(path);
+				if(indata.fail())
+				{
+					throw std::runtime_error("File path: '"+path+"' doesn't exist");
+				}
+				std::string line="";
+				size_t rows=0, cols=0;
+				char comma;
+				if(!getline(indata,line) || !(std::istringstream(line)>>rows>>comma>>cols))
+				{
+					throw std::runtime_error("File path: '"+path+"' has no 'rows,cols' header");
+				}
+				std::vector<Triplet> triplets;
+				while(getline(indata,line))
+				{
+					if(line.empty())
+					{
+						continue;
+					}
+					std::stringstream lineStream(line);
+					std::string cell;
+					Triplet t;
+					if(!std::getline(lineStream,cell,','))
+					{
+						continue;
+					}
+					t.row=std::stoul(cell);
+					if(!std::getline(lineStream,cell,','))
+					{
+						throw std::runtime_error("Malformed line in '"+path+"': "+line);
+					}
+					t.col=std::stoul(cell);
+					if(!std::getline(lineStream,cell,','))
+					{
+						throw std::runtime_error("Malformed line in '"+path+"': "+line);
+					}
+					t.value=convert_to<T>(cell);
+					triplets.push_back(t);
+				}
+				indata.close();
+				return from_triplets(rows,cols,triplets);
+			}
+
+			/**
+			 * @brief Store the Matrix in the sparse COO text format read by load_COO().
+			 * @param path = "path to destination file"
+			 * @return Returns false if the destination file could not be opened or written.
+			 */
+			bool store_COO(const std::string &path) const
+			{
+				std::ofstream file;
+				file.open(path);
+				if(file.fail())
+				{
+					return false;
+				}
+				file<<n_rows<<","<<n_cols<<"\n";
+				for(size_t i=0;i<n_rows;i++)
+				{
+					for(size_t p=row_ptr[i];p<row_ptr[i+1];p++)
+					{
+						file<<i<<","<<col_idx[p]<<","<<values[p]<<"\n";
+					}
+				}
+				file.close();
+				return !file.fail();
+			}
+
+			/**
+			 * @return Returns the dense form of the Matrix as a 2D vector.
+			 */
+			std::vector<std::vector<T>> to_dense() const
+			{
+				std::vector<std::vector<T>> MAT(n_rows,std::vector<T>(n_cols,T(0)));
+				for(size_t i=0;i<n_rows;i++)
+				{
+					for(size_t p=row_ptr[i];p<row_ptr[i+1];p++)
+					{
+						MAT[i][col_idx[p]]=values[p];
+					}
+				}
+				return MAT;
+			}
+
+			/**
+			 * @brief Sparse x Dense multiplication (SpMM). Rows of the result are split between the workers of the pool, every row of the result is
+			 * the sum of the rows of B selected by the non zeros of the matching row of this Matrix.
+			 * @param B = Dense Matrix of size cols() x k
+			 * @param pool = Pool to run on
+			 * @return Dense result of size rows() x k
+			 */
+			std::vector<std::vector<T>> multiply(const std::vector<std::vector<T>> &B, ThreadPool &pool) const
+			{
+				if(B.size()!=n_cols)
+				{
+					throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+				}
+				size_t k=B.empty()? 0 : B[0].size();
+				std::vector<std::vector<T>> C(n_rows,std::vector<T>(k,T(0)));
+				parallel_for(pool,0,n_rows,[&](size_t lo, size_t hi){
+					for(size_t i=lo;i<hi;i++)
+					{
+						T* c=C[i].data();
+						for(size_t p=row_ptr[i];p<row_ptr[i+1];p++)
+						{
+							const T a=values[p];
+							const T* b=B[col_idx[p]].data();
+							for(size_t j=0;j<k;j++)
+							{
+								c[j]+=a*b[j];
+							}
+						}
+					}
+				});
+				return C;
+			}
+
+			/**
+			 * @brief SpMM on a temporary pool.
+			 * @param B = Dense Matrix of size cols() x k
+			 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+			 */
+			std::vector<std::vector<T>> multiply(const std::vector<std::vector<T>> &B, size_t n_threads=0) const
+			{
+				ThreadPool pool(n_threads);
+				return multiply(B,pool);
+			}
+
+			/**
+			 * @brief Sparse x Sparse multiplication (SpGEMM) using Gustavson's row by row algorithm. Every chunk of rows uses its own dense accumulator
+			 * and marker array of size B.cols(), the chunks are concatenated into the CSR result once all of them are done.
+			 * @param B = Sparse Matrix of size cols() x k
+			 * @param pool = Pool to run on
+			 * @return Sparse result of size rows() x k
+			 */
+			SparseMatrix multiply(const SparseMatrix &B, ThreadPool &pool) const
+			{
+				if(B.n_rows!=n_cols)
+				{
+					throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+				}
+				// Per row results, kept separately until the final offsets are known.
+				std::vector<std::vector<size_t>> row_cols(n_rows);
+				std::vector<std::vector<T>> row_vals(n_rows);
+				parallel_for(pool,0,n_rows,[&](size_t lo, size_t hi){
+					std::vector<T> accumulator(B.n_cols,T(0));
+					std::vector<size_t> marker(B.n_cols,(size_t)-1);
+					std::vector<size_t> touched;
+					for(size_t i=lo;i<hi;i++)
+					{
+						touched.clear();
+						for(size_t p=row_ptr[i];p<row_ptr[i+1];p++)
+						{
+							const T a=values[p];
+							const size_t r=col_idx[p];
+							for(size_t q=B.row_ptr[r];q<B.row_ptr[r+1];q++)
+							{
+								const size_t j=B.col_idx[q];
+								if(marker[j]!=i)
+								{
+									marker[j]=i;
+									accumulator[j]=T(0);
+									touched.push_back(j);
+								}
+								accumulator[j]+=a*B.values[q];
+							}
+						}
+						std::sort(touched.begin(),touched.end());
+						for(size_t j: touched)
+						{
+							if(accumulator[j]!=T(0))
+							{
+								row_cols[i].push_back(j);
+								row_vals[i].push_back(accumulator[j]);
+							}
+						}
+					}
+				});
+				SparseMatrix C(n_rows,B.n_cols);
+				for(size_t i=0;i<n_rows;i++)
+				{
+					C.col_idx.insert(C.col_idx.end(),row_cols[i].begin(),row_cols[i].end());
+					C.values.insert(C.values.end(),row_vals[i].begin(),row_vals[i].end());
+					C.row_ptr[i+1]=C.values.size();
+				}
+				return C;
+			}
+
+			/**
+			 * @brief SpGEMM on a temporary pool.
+			 * @param B = Sparse Matrix of size cols() x k
+			 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+			 */
+			SparseMatrix multiply(const SparseMatrix &B, size_t n_threads=0) const
+			{
+				ThreadPool pool(n_threads);
+				return multiply(B,pool);
+			}
+		};
+
+		/**
+		 * @brief Opt-in on-disk cache of results of the file based operations of MATOPS::BigMatrix<Data1> (see MATOPS::BigMatrix<Data1>::enable_cache).
+		 *
+		 * A result is stored as <dir>/<key>.csv, where the key is a 64 bit FNV-1a hash of the operation name, its parameters (datatype, LEAF_SIZE, ...)
+		 * and the contents of all input files. The content hash of an input file is remembered in <dir>/index.txt together with the file's size and
+		 * modification time, so an unchanged input is not read again. On a hit the cached result is reflinked (on file systems that support it) or copied
+		 * to the destination. Every hit refreshes the modification time of the entry, and once the entries take more than max_bytes the least recently
+		 * used ones are deleted.
+		 */
+		class ResultCache
+		{
+			struct FileStamp
+			{
+				uintmax_t size;
+				long long mtime;
+				uint64_t hash;
+			};
+
+			std::filesystem::path dir;
+			uintmax_t max_bytes;
+			std::map<std::string,FileStamp> stamps; // Content hash of every input seen, keyed by absolute path
+			size_t index_lines=0;                   // Lines in index.txt, the later line of a path wins
+			std::mutex cache_mutex;
+			std::atomic<size_t> n_hits{0};
+			std::atomic<size_t> n_misses{0};
+
+			static const size_t MAX_STAMPS=4096; // Inputs remembered in index.txt
+
+			static const uint64_t FNV_OFFSET=14695981039346656037ULL;
+			static const uint64_t FNV_PRIME=1099511628211ULL;
+
+			static uint64_t fnv1a(const char* data, size_t n, uint64_t h=FNV_OFFSET)
+			{
+				for(size_t i=0;i<n;i++)
+				{
+					h^=(unsigned char)data[i];
+					h*=FNV_PRIME;
+				}
+				return h;
+			}
+
+			static long long mtime_of(const std::filesystem::path &p)
+			{
+				return (long long)std::filesystem::last_write_time(p).time_since_epoch().count();
+			}
+
+			// Content hash of an input file, recomputed only if its size or modification time changed.
+			uint64_t content_hash(const std::string &file)
+			{
+				std::filesystem::path p=std::filesystem::absolute(file);
+				uintmax_t size=std::filesystem::file_size(p);
+				long long mtime=mtime_of(p);
+				std::map<std::string,FileStamp>::iterator it=stamps.find(p.string());
+				if(it!=stamps.end() && it->second.size==size && it->second.mtime==mtime)
+				{
+					return it->second.hash;
+				}
+				std::ifstream indata(p,std::ios::binary);
+				std::vector<char> buffer(1<<16);
+				uint64_t h=FNV_OFFSET;
+				while(indata.read(buffer.data(),buffer.size()) || indata.gcount()>0)
+				{
+					h=fnv1a(buffer.data(),indata.gcount(),h);
+				}
+				FileStamp stamp={size,mtime,h};
+				stamps[p.string()]=stamp;
+				append_index(p.string(),stamp);
+				return h;
+			}
+
+			void load_index()
+			{
+				std::ifstream indata(dir/"index.txt");
+				FileStamp stamp;
+				std::string path;
+				while(indata>>stamp.hash>>stamp.size>>stamp.mtime && std::getline(indata>>std::ws,path))
+				{
+					stamps[path]=stamp;
+					index_lines++;
+				}
+			}
+
+			// Add one stamp to index.txt. The file is only rewritten when it holds too many superseded lines or too many inputs, in the latter case
+			// the stamps of inputs that were deleted or changed since are dropped first, and all of them if that is not enough.
+			void append_index(const std::string &path, const FileStamp &stamp)
+			{
+				if(stamps.size()<=MAX_STAMPS && index_lines<2*stamps.size()+64)
+				{
+					std::ofstream file(dir/"index.txt",std::ios::app);
+					file<<stamp.hash<<" "<<stamp.size<<" "<<stamp.mtime<<" "<<path<<"\n";
+					index_lines++;
+					return;
+				}
+				if(stamps.size()>MAX_STAMPS)
+				{
+					for(std::map<std::string,FileStamp>::iterator it=stamps.begin();it!=stamps.end();)
+					{
+						std::error_code err;
+						uintmax_t size=std::filesystem::file_size(it->first,err);
+						bool current=!err && size==it->second.size && mtime_of(it->first)==it->second.mtime;
+						it= current? std::next(it) : stamps.erase(it);
+					}
+					if(stamps.size()>MAX_STAMPS)
+					{
+						stamps.clear();
+					}
+					stamps[path]=stamp;
+				}
+				std::ofstream file(dir/"index.txt");
+				for(const std::pair<const std::string,FileStamp> &s: stamps)
+				{
+					file<<s.second.hash<<" "<<s.second.size<<" "<<s.second.mtime<<" "<<s.first<<"\n";
+				}
+				index_lines=stamps.size();
+			}
+
+			// Reflink src to dest where the file system supports it, copy otherwise.
+			static void clone_file(const std::filesystem::path &src, const std::filesystem::path &dest)
+			{
+				#if defined(__linux__) && defined(FICLONE)
+				int in=open(src.c_str(),O_RDONLY);
+				int out=open(dest.c_str(),O_WRONLY|O_CREAT|O_TRUNC,0644);
+				bool cloned=(in>=0 && out>=0 && ioctl(out,FICLONE,in)==0);
+				if(in>=0) close(in);
+				if(out>=0) close(out);
+				if(cloned)
+				{
+					return;
+				}
+				#endif
+				std::filesystem::copy_file(src,dest,std::filesystem::copy_options::overwrite_existing);
+			}
+
+			// Delete the least recently used entries until the cache fits in max_bytes.
+			void evict()
+			{
+				std::vector<std::pair<long long,std::filesystem::path>> entries;
+				uintmax_t total=0;
+				for(const std::filesystem::directory_entry &e: std::filesystem::directory_iterator(dir))
+				{
+					if(e.path().extension()==".csv")
+					{
+						total+=e.file_size();
+						entries.push_back(std::make_pair(mtime_of(e.path()),e.path()));
+					}
+				}
+				std::sort(entries.begin(),entries.end());
+				for(size_t i=0;i<entries.size() && total>max_bytes;i++)
+				{
+					total-=std::filesystem::file_size(entries[i].second);
+					std::filesystem::remove(entries[i].second);
+				}
+			}
+
+			public:
+
+			/**
+			 * @param cache_dir = Directory holding the cached results (created if it doesn't exist)
+			 * @param max_size = Upper bound (in bytes) on the size of the cached results
+			 */
+			ResultCache(const std::string &cache_dir, uintmax_t max_size):dir(cache_dir),max_bytes(max_size)
+			{
+				std::filesystem::create_directories(dir);
+				load_index();
+			}
+
+			/**
+			 * @brief Cache key of an operation.
+			 * @param operation = Name of the operation, Eg. "matmul"
+			 * @param inputs = Input files, hashed by content
+			 * @param params = Everything else the result depends on (datatype, algorithm parameters, ...)
+			 * @return 16 hex digit key. Throws std::filesystem::filesystem_error if an input doesn't exist.
+			 */
+			std::string key(const std::string &operation, const std::vector<std::string> &inputs, const std::string &params)
+			{
+				std::lock_guard<std::mutex> lock(cache_mutex);
+				uint64_t h=fnv1a(operation.data(),operation.size());
+				h=fnv1a(params.data(),params.size(),h);
+				for(const std::string &input: inputs)
+				{
+					uint64_t c=content_hash(input);
+					h=fnv1a((const char*)&c,sizeof(c),h);
+				}
+				std::ostringstream hex;
+				hex<<std::hex<<h;
+				return hex.str();
+			}
+
+			/**
+			 * @brief Produce the cached result of key at dest.
+			 * @return True on a hit, false (nothing is written) on a miss.
+			 */
+			bool fetch(const std::string &key, const std::string &dest)
+			{
+				std::lock_guard<std::mutex> lock(cache_mutex);
+				std::filesystem::path entry=dir/(key+".csv");
+				if(!std::filesystem::exists(entry))
+				{
+					n_misses++;
+					return false;
+				}
+				clone_file(entry,dest);
+				std::filesystem::last_write_time(entry,std::filesystem::file_time_type::clock::now()); // Refresh the LRU position
+				n_hits++;
+				return true;
+			}
+
+			/**
+			 * @brief Add the result stored at src to the cache under key and evict old entries if the cache got too large.
+			 */
+			void store(const std::string &key, const std::string &src)
+			{
+				std::lock_guard<std::mutex> lock(cache_mutex);
+				if(!std::filesystem::exists(src))
+				{
+					return;
+				}
+				clone_file(src,dir/(key+".csv"));
+				std::filesystem::last_write_time(dir/(key+".csv"),std::filesystem::file_time_type::clock::now());
+				evict();
+			}
+
+			/**
+			 * @return Returns the number of fetch() calls that found a cached result.
+			 */
+			size_t hits() const
+			{
+				return n_hits;
+			}
+
+			/**
+			 * @return Returns the number of fetch() calls that found nothing.
+			 */
+			size_t misses() const
+			{
+				return n_misses;
+			}
+		};
+
+		/**
+		 * @brief Row offset index of a CSV file: the byte offset at which every (non empty) row starts, stored next to the file as a "<file>.idx" sidecar.
+		 * With it any row range can be read by seeking straight to its first row (see MATOPS::BigMatrix<Data1>::load_submatrix) and a file can be cut into
+		 * parts of equal size at exact row boundaries for parallel parsers.
+		 *
+		 * The sidecar holds a text header "MATOPS-CSV-INDEX 1 <file size> <mtime> <rows> <cols>" followed by rows+1 binary 64 bit offsets, the last one
+		 * being the file size. It is only trusted while the size and the modification time of the CSV file match the header.
+		 */
+		class CsvIndex
+		{
+			std::string file;
+			uintmax_t file_size=0;
+			long long file_mtime=0;
+			size_t n_cols=0;
+			std::vector<uint64_t> offsets; // offsets[i] = start of row i, offsets[rows] = file size
+
+			static long long mtime_of(const std::string &path)
+			{
+				return (long long)std::filesystem::last_write_time(path).time_since_epoch().count();
+			}
+
+			public:
+
+			CsvIndex() = default;
+
+			/**
+			 * @brief Constructs an index from the row offsets collected while parsing a file (Eg. by MATOPS::BigMatrix<Data1>::read_CSV).
+			 * @param path = "path to A.csv"
+			 * @param row_offsets = Start of every non empty row
+			 * @param cols = No. of Columns
+			 */
+			CsvIndex(const std::string &path, std::vector<uint64_t> row_offsets, size_t cols)
+				:file(path),file_size(std::filesystem::file_size(path)),file_mtime(mtime_of(path)),n_cols(cols),offsets(std::move(row_offsets))
+			{
+				offsets.push_back(file_size);
+			}
+
+			/**
+			 * @brief Build the index of a CSV file with one pass over its bytes, no value is parsed.
+			 * @param path = "path to A.csv"
+			 * @return The index. Throws std::runtime_error if the file doesn't exist.
+			 */
+			static CsvIndex build(const std::string &path)
+			{
+				std::ifstream indata(path,std::ios::binary);
+				if(indata.fail())
+				{
+					throw std::runtime_error("File path: '"+path+"' doesn't exist");
+				}
+				std::vector<uint64_t> row_offsets;
+				size_t cols=0;
+				bool line_start=true, first_row=true;
+				uint64_t position=0;
+				std::vector<char> buffer(size_t(1)<<20);
+				while(indata)
+				{
+					indata.read(buffer.data(),buffer.size());
+					std::streamsize got=indata.gcount();
+					for(std::streamsize i=0;i<got;i++,position++)
+					{
+						char ch=buffer[i];
+						if(ch=='\n' || ch=='\r')
+						{
+							if(!line_start)
+							{
+								first_row=false;
+							}
+							line_start=true;
+							continue;
+						}
+						if(line_start)
+						{
+							row_offsets.push_back(position);
+							line_start=false;
+							if(first_row)
+							{
+								cols=1;
+							}
+						}
+						if(first_row && ch==',')
+						{
+							cols++;
+						}
+					}
+				}
+				indata.close();
+				return CsvIndex(path,std::move(row_offsets),cols);
+			}
+
+			/**
+			 * @brief Load the sidecar of a CSV file, building (and saving) a fresh index when the sidecar is missing or stale.
+			 * @param path = "path to A.csv"
+			 * @return The index. Throws std::runtime_error if the file doesn't exist.
+			 */
+			static CsvIndex open(const std::string &path)
+			{
+				CsvIndex index;
+				if(index.load(path))
+				{
+					return index;
+				}
+				index=build(path);
+				index.save();
+				return index;
+			}
+
+			/**
+			 * @brief Read the sidecar of a CSV file.
+			 * @return Returns false if there is no sidecar or it doesn't match the current file.
+			 */
+			bool load(const std::string &path)
+			{
+				std::error_code err;
+				uintmax_t size=std::filesystem::file_size(path,err);
+				if(err)
+				{
+					return false;
+				}
+				std::ifstream indata(path+".idx",std::ios::binary);
+				std::string magic;
+				int version=0;
+				uintmax_t idx_size=0;
+				long long idx_mtime=0;
+				size_t rows=0, cols=0;
+				if(!(indata>>magic>>version>>idx_size>>idx_mtime>>rows>>cols) || magic!="MATOPS-CSV-INDEX" || version!=1
+					|| idx_size!=size || idx_mtime!=mtime_of(path))
+				{
+					return false;
+				}
+				indata.get(); // '\n' ending the header
+				std::vector<uint64_t> row_offsets(rows+1);
+				if(!indata.read((char*)row_offsets.data(),row_offsets.size()*sizeof(uint64_t)) || row_offsets.back()!=size)
+				{
+					return false;
+				}
+				file=path;
+				file_size=size;
+				file_mtime=idx_mtime;
+				n_cols=cols;
+				offsets=std::move(row_offsets);
+				return true;
+			}
+
+			/**
+			 * @brief Write the sidecar "<file>.idx".
+			 * @return Returns false if the sidecar could not be written (Eg. read only directory), the index stays usable in memory.
+			 */
+			bool save() const
+			{
+				std::ofstream out(file+".idx",std::ios::binary|std::ios::trunc);
+				if(out.fail())
+				{
+					return false;
+				}
+				out<<"MATOPS-CSV-INDEX 1 "<<file_size<<" "<<file_mtime<<" "<<rows()<<" "<<n_cols<<"\n";
+				out.write((const char*)offsets.data(),offsets.size()*sizeof(uint64_t));
+				return (bool)out;
+			}
+
+			/**
+			 * @return Returns the No. of (non empty) rows of the file.
+			 */
+			size_t rows() const
+			{
+				return offsets.empty()? 0 : offsets.size()-1;
+			}
+
+			/**
+			 * @return Returns the No. of cells in the first row of the file.
+			 */
+			size_t cols() const
+			{
+				return n_cols;
+			}
+
+			/**
+			 * @return Returns the byte offset at which row i starts, row_offset(rows()) is the file size.
+			 */
+			uint64_t row_offset(size_t i) const
+			{
+				return offsets[i];
+			}
+
+			/**
+			 * @brief Cut the file into parts of about the same number of bytes at row boundaries, Eg. to parse it with one thread per part.
+			 * @param parts = No. of parts
+			 * @return The first row of every part followed by rows(), i.e. part p is the row range [split[p], split[p+1]).
+			 */
+			std::vector<size_t> split_points(size_t parts) const
+			{
+				std::vector<size_t> split(1,0);
+				for(size_t p=1;p<parts;p++)
+				{
+					uint64_t target=file_size*p/parts;
+					size_t row=std::lower_bound(offsets.begin(),offsets.end()-1,target)-offsets.begin();
+					split.push_back(std::max(row,split.back()));
+				}
+				split.push_back(rows());
+				return split;
+			}
+		};
+
+		#ifdef __linux__
+		template<typename Data1> class MatmulService;
+
+		/**
+		 * @brief CPUs of the calling process grouped by socket (physical package), as reported by /sys/devices/system/cpu. Used to pin the workers of
+		 * MATOPS::BigMatrix<Data1>::matmul_distributed round robin over the sockets.
+		 */
+		inline std::vector<std::vector<int>> cpu_sockets()
+		{
+			cpu_set_t allowed;
+			CPU_ZERO(&allowed);
+			sched_getaffinity(0,sizeof(allowed),&allowed);
+			std::map<int,std::vector<int>> sockets;
+			for(int cpu=0;cpu<CPU_SETSIZE;cpu++)
+			{
+				if(!CPU_ISSET(cpu,&allowed))
+				{
+					continue;
+				}
+				int package=0;
+				std::ifstream topology("/sys/devices/system/cpu/cpu"+std::to_string(cpu)+"/topology/physical_package_id");
+				topology>>package;
+				sockets[package].push_back(cpu);
+			}
+			std::vector<std::vector<int>> result;
+			for(const std::pair<const int,std::vector<int>> &s: sockets)
+			{
+				result.push_back(s.second);
+			}
+			return result;
+		}
+
+		/**
+		 * @brief Block exchange layer of the SUMMA multiplication over a POSIX shared memory segment. SUMMA only needs two collective operations,
+		 * broadcasting a panel of A along a process row and a panel of B along a process column, plus a barrier. Here a broadcast is the owner writing
+		 * the panel into the row (or column) slot of the segment followed by a barrier. Replacing this class by one that sends the panels over a real
+		 * transport leaves the decomposition and the worker loop unchanged.
+		 * @tparam T = DataType of the Matrix
+		 */
+		template<typename T>
+		class ShmTransport
+		{
+			struct Header
+			{
+				pthread_barrier_t barrier;
+			};
+
+			std::string name;
+			void* base=MAP_FAILED;
+			size_t bytes=0;
+			size_t panel_elems=0;  // Size of one panel slot
+			int n_rows=0, n_cols=0; // Process grid
+
+			static size_t align(size_t offset)
+			{
+				return (offset+63)/64*64;
+			}
+
+			public:
+
+			size_t offset_A=0, offset_B=0, offset_C=0, offset_row_panels=0, offset_col_panels=0;
+
+			/**
+			 * @brief Create the segment (launcher side): room for A (m x k), B (k x n), C (m x n) and one panel slot per process row and column.
+			 * @param segment = Name of the segment, Eg. "/matops_<pid>"
+			 * @param m, k, n = Dimensions of the product
+			 * @param grid_rows, grid_cols = Process grid
+			 * @param panel_size = Max. No. of elements of a panel
+			 */
+			ShmTransport(const std::string &segment, size_t m, size_t k, size_t n, int grid_rows, int grid_cols, size_t panel_size)
+				:name(segment),panel_elems(panel_size),n_rows(grid_rows),n_cols(grid_cols)
+			{
+				offset_A=align(sizeof(Header));
+				offset_B=align(offset_A+m*k*sizeof(T));
+				offset_C=align(offset_B+k*n*sizeof(T));
+				offset_row_panels=align(offset_C+m*n*sizeof(T));
+				offset_col_panels=align(offset_row_panels+grid_rows*panel_elems*sizeof(T));
+				bytes=align(offset_col_panels+grid_cols*panel_elems*sizeof(T));
+
+				int fd=shm_open(name.c_str(),O_CREAT|O_EXCL|O_RDWR,0600);
+				if(fd<0)
+				{
+					throw std::runtime_error("Can't create shared memory segment '"+name+"'");
+				}
+				if(ftruncate(fd,bytes)!=0)
+				{
+					close(fd);
+					shm_unlink(name.c_str());
+					throw std::runtime_error("Can't size shared memory segment '"+name+"'");
+				}
+				base=mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+				close(fd);
+				if(base==MAP_FAILED)
+				{
+					shm_unlink(name.c_str());
+					throw std::runtime_error("Can't map shared memory segment '"+name+"'");
+				}
+				pthread_barrierattr_t attr;
+				pthread_barrierattr_init(&attr);
+				pthread_barrierattr_setpshared(&attr,PTHREAD_PROCESS_SHARED);
+				pthread_barrier_init(&((Header*)base)->barrier,&attr,grid_rows*grid_cols);
+				pthread_barrierattr_destroy(&attr);
+			}
+
+			ShmTransport(const ShmTransport&) = delete;
+			ShmTransport& operator=(const ShmTransport&) = delete;
+
+			/**
+			 * Destructor: unmaps and removes the segment. The forked workers inherit the mapping, they leave with _exit() and never run this.
+			 */
+			~ShmTransport()
+			{
+				if(base!=MAP_FAILED)
+				{
+					pthread_barrier_destroy(&((Header*)base)->barrier);
+					munmap(base,bytes);
+					shm_unlink(name.c_str());
+				}
+			}
+
+			/**
+			 * @return Returns a pointer to the array stored at offset in the segment.
+			 */
+			T* at(size_t offset)
+			{
+				return (T*)((char*)base+offset);
+			}
+
+			/**
+			 * @brief Wait until every worker of the grid reached the barrier.
+			 */
+			void barrier()
+			{
+				pthread_barrier_wait(&((Header*)base)->barrier);
+			}
+
+			/**
+			 * @return Returns the panel slot of a process row (A panels).
+			 */
+			T* row_panel(int grid_row)
+			{
+				return at(offset_row_panels)+grid_row*panel_elems;
+			}
+
+			/**
+			 * @return Returns the panel slot of a process column (B panels).
+			 */
+			T* col_panel(int grid_col)
+			{
+				return at(offset_col_panels)+grid_col*panel_elems;
+			}
+		};
+		#endif
+
+		/**
+		 * @brief This is the Class for handling Large Matrices. It takes in large Matrices stored as comma-separated values (CSV) files and perform both Multiplication 
+		 * (Strassan's Algorithm) and transpose. It contains all the important functions namely ,matmul function, StrassanMultiply function and other helper functions 
+		 * that are needed for smooth functioning of the library. This class also contains blocks of code that are gated by the SET_LEAF_SIZE flag, for example the 
+		 * set_LEAF_SIZE() function and the set_configerd_Leaf_size() function. When matrix.h is compiled with the SET_LEAF_SIZE flag raised the set_LEAF_SIZE() function is active
+		 * and set_configerd_Leaf_size() function is inactive. And the vice-versa happens when matrix.h is compiled without the SET_LEAF_SIZE flag.
+		 *
+		 * Instead of reading configure.txt at run time, the LEAF_SIZE can be fixed at compile time with the STATIC_LEAF_SIZE parameter, Eg. with the
+		 * MATOPS::TunedBigMatrix alias that uses the value written to matrix_config.h by configure_lib.cpp. The base case of StrassenMultiply is then
+		 * a kernel instantiated for exactly STATIC_LEAF_SIZE x STATIC_LEAF_SIZE blocks, whose loop bounds are known to the compiler.
+		 * 
+		 * @tparam Data1 = Datatype of the BigMatrix. Eg. int, float, double etc.
+		 * @tparam STATIC_LEAF_SIZE = Compile time LEAF_SIZE, 0 (the default) selects the run time LEAF_SIZE.
+		 */
+		// BIG MATRIX Multiplication and Transpose
+		template<typename Data1, int STATIC_LEAF_SIZE=0>
+		class BigMatrix
+		{
+			#ifdef __linux__
+			friend class MatmulService<Data1>; // Keeps the LEAF_SIZE, pool and Strassen buffers warm between requests
+			#endif
+			int LEAF_SIZE=STATIC_LEAF_SIZE; // Private variable LEAF_SIZE 
+			bool LEAF_SIZE_PINNED=false; // True once set_LEAF_SIZE() was called, configure.txt is then ignored
+			double SPARSE_THRESHOLD=0.05; // Density at or below which matmul switches to the sparse kernels
+			Quantization QUANTIZATION=Quantization::NONE; // Operand precision of matmul
+			static const size_t GEMV_MAX_COLS=8; // matmul streams A through matmul_gemv when B has at most this many columns
+			static const size_t GEMV_STRIPE=1024; // Rows of A per matmul_gemv task
+			static const size_t STREAM_STRIPE=1024; // Rows per task of the streaming element-wise operations and reductions
+			std::shared_ptr<ResultCache> CACHE; // Optional result cache, see enable_cache()
+			static const size_t SUMMA_PANEL=64; // Max. width of the panels exchanged by matmul_distributed
+			bool CSV_INDEX=false; // Write the row offset sidecar of every parsed file, see enable_csv_index()
+			static const size_t LU_LEAF=64; // Panels of at most this many columns are factored without recursion
+			double INCREMENTAL_THRESHOLD=0.25; // Changed fraction above which the incremental updates recompute the whole product
+			/**
+			 * \privatesection
+			 */
+			private:
+
+			/**
+			 * @brief Function to dynamically allocate/initialize a rows x cols matrix in the memory. The row pointers and the elements live in one
+			 * block from MATOPS::huge_alloc (huge pages for large matrices), the elements are stored row major right after the row pointers.
+			 * @param rows = No. of rows of the BigMatrix.
+			 * @param cols = No. of cols of the BigMatrix.
+			 * @return Returns a pointer pointing to a memory location containing 0 matrix of size rows x cols, to be freed with Free_matrix.
+			 *
+			 */
+			Data1** Init_matrix(size_t rows, size_t cols)
+			{
+				size_t pointers=(rows*sizeof(Data1*)+63)/64*64;
+				Data1** M=(Data1**)huge_alloc(pointers+rows*cols*sizeof(Data1));
+				Data1* elements=(Data1*)((char*)M+pointers);
+				for(size_t i=0;i<rows;i++)
+				{
+					M[i]=elements+i*cols;
+				}
+				return M;
+			}
+
+			/**
+			 * @brief Function to dynamically allocate/initialize an n x n matrix in the memory.
+			 * @param n = No. of rows and cols of the BigMatrix.
+			 * @return Returns a pointer pointing to a memory location containing 0 matrix of size n x n.
+			 */
+			Data1** Init_matrix(size_t n)
+			{
+				return Init_matrix(n,n);
+			}
+
+			/**
+			 * @brief Function to Add 2 square Matrices of size n.
+			 * @param M1 = Pointer pointing to BigMatrix M1 loaded into memory  
+			 * @param M2 = Pointer pointing to BigMatrix M2 loaded into memory 
+			 * @param n  = Size of the Matrices
+			 * @return Returns a pointer pointing to a memory location containing the sum of M1 and M2
+			 */
+			// Matrix ADD ===================
+			Data1** add(Data1** M1, Data1** M2, size_t n)
+			{
+				Data1** temp = Init_matrix(n);
+			    for(size_t i=0; i<n; i++)
+			        for(size_t j=0; j<n; j++)
+			            temp[i][j] = M1[i][j] + M2[i][j];
+			    return temp;
+			}
+
+			/**
+			 * @brief Function to Subtract 2 square Matrices of size n.
+			 * @param M1 = Pointer pointing to BigMatrix M1 loaded into memory 
+			 * @param M2 = Pointer pointing to BigMatrix M2 loaded into memory 
+			 * @param n  = Size of the Matrices
+			 * @return Returns a pointer pointing to a memory location containing the difference of M1 and M2
+			 */
+			// Matrix SUBTRACT ===============
+			Data1** sub(Data1** M1, Data1** M2, size_t n)
+			{
+				Data1** temp = Init_matrix(n);
+				for(size_t i=0; i<n; i++)
+					for(size_t j=0; j<n; j++)
+						temp[i][j] = M1[i][j] - M2[i][j];
+				return temp;
+			}
+
+			/**
+			 * @brief Base case kernel of StrassenMultiply for a compile time block size L: C += A x B on L x L blocks. The i-k-j loop order keeps the
+			 * inner loop contiguous, and with constant bounds the compiler can fully unroll and vectorize it.
+			 * @tparam L = Block size (STATIC_LEAF_SIZE)
+			 */
+			template<int L>
+			static void leaf_multiply(Data1** A, Data1** B, Data1** C)
+			{
+				for(int i=0;i<L;i++)
+				{
+					Data1* c=C[i];
+					for(int k=0;k<L;k++)
+					{
+						const Data1 a=A[i][k];
+						const Data1* b=B[k];
+						for(int j=0;j<L;j++)
+						{
+							c[j]+=a*b[j];
+						}
+					}
+				}
+			}
+
+			/**
+			 * @brief Owner of the temporary Matrices of one StrassenMultiply level: everything passed to keep() is freed when the level returns or unwinds.
+			 */
+			struct ScratchMatrices
+			{
+				std::vector<Data1**> blocks;
+
+				ScratchMatrices()
+				{
+					blocks.reserve(33); // A level keeps 33 temporaries, keep() never has to grow the vector
+				}
+
+				Data1** keep(Data1** M)
+				{
+					blocks.push_back(M);
+					return M;
+				}
+
+				~ScratchMatrices()
+				{
+					for(Data1** M: blocks)
+					{
+						huge_free(M); // Same as Free_matrix
+					}
+				}
+			};
+
+			/**
+			 * @brief The main Strassen's Algorithm function implemented using recursion. Takes in square Matrices A and B.
+			 * @param A = BigMatrix A
+			 * @param B = BigMatrix B
+			 * @param n = Size of both A and B
+			 * @return Returns a square matrix i.e. the Multiplication result of A and B.
+			 * 
+			 * The LEAF_SIZE is set by the MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function from witin the MATOPS::BigMatrix<Data1>::matmul() function. The input Matrices 
+			 * A and B are both broken down into 4 blocks, these matrices are used to calculate the 7 Strassen's coeffcient matrices. In order to calculate the Strassen's Coefficent
+			 * the StrassenMultiply function is recurssively called. Once the matrix sizes becomes equal to or less than LEAF_SIZE, we hit the base condition and perform the Matrix 
+			 * multiplication using the O(n^3) solution. Finally all the callocated memory (allocated by Init_matrix()) is freed up.
+			 * 
+			 * When a pool is given, the 7 coefficient products of the top parallel_depth recursion levels are run as tasks on the pool (7^parallel_depth
+			 * independent products), below that the recursion is sequential.
+			 * @param pool = Optional pool for the parallel path
+			 * @param parallel_depth = No. of recursion levels to run in parallel
+			 */
+			Data1** StrassenMultiply(Data1** A, Data1** B, size_t n, ThreadPool* pool=NULL, int parallel_depth=0)
+			{   
+				/* Naive Strassan's Algorithm (more time consuming)
+				  if(n==1)
+				{
+					Data1** C=Init_matrix(1);
+					C[0][0]=A[0][0]*B[0][0];
+					return C;
+				}*/
+
+				// Once array size of LEAF_SIZE x LEAF_SIZE or lesser is reached we switch to the O(n^3) Matrix Multiplication solution, since after this 
+				// stage the recursion calls become a burden to the whole algorithm and we end up getting high execution time. The LEAF_SIZE is set by the
+				// MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function from witin the MATOPS::BigMatrix<Data1>::matmul() function.
+				if(n<=(size_t)LEAF_SIZE)
+				{
+					Data1** C=Init_matrix(n);
+					if(STATIC_LEAF_SIZE>0 && n==(size_t)STATIC_LEAF_SIZE)
+					{
+						leaf_multiply<(STATIC_LEAF_SIZE>0)? STATIC_LEAF_SIZE : 1>(A,B,C);
+						return C;
+					}
+					for(size_t i=0;i<n;i++)
+					{
+						for(size_t j=0;j<n;j++)
+						{
+							for(size_t k=0;k<n;k++)
+							{
+								C[i][j]+=A[i][k]*B[k][j];
+							}
+						}
+					}
+					return C;
+				}
+
+				size_t k = n/2;
+				ScratchMatrices scratch; // Frees every temporary of this level, also when a product below throws (Eg. std::bad_alloc)
+
+				// Initialize the Block Matrices
+				Data1** A11 = scratch.keep(Init_matrix(k));
+				Data1** A12 = scratch.keep(Init_matrix(k));
+				Data1** A21 = scratch.keep(Init_matrix(k));
+				Data1** A22 = scratch.keep(Init_matrix(k));
+				Data1** B11 = scratch.keep(Init_matrix(k));
+				Data1** B12 = scratch.keep(Init_matrix(k));
+				Data1** B21 = scratch.keep(Init_matrix(k));
+				Data1** B22 = scratch.keep(Init_matrix(k));
+
+				// Build the block Matrices
+				for(size_t i=0;i<k;i++)
+				{
+					for(size_t j=0;j<k;j++)
+					{
+						A11[i][j] = A[i][j];
+						A12[i][j] = A[i][k+j];
+						A21[i][j] = A[k+i][j];
+						A22[i][j] = A[k+i][k+j];
+						B11[i][j] = B[i][j];
+						B12[i][j] = B[i][k+j];
+						B21[i][j] = B[k+i][j];
+						B22[i][j] = B[k+i][k+j];
+					}
+				}
+				// Determine the Strassen's Coefficients
+				Data1** TEMP_B12_B22 = scratch.keep(sub(B12, B22, k));
+				Data1** TEMP_A11_A12 = scratch.keep(add(A11, A12, k));
+				Data1** TEMP_A21_A22 = scratch.keep(add(A21, A22, k));
+				Data1** TEMP_B21_B11 = scratch.keep(sub(B21, B11, k));
+
+				Data1** TEMP_A11_A22 = scratch.keep(add(A11, A22, k));
+				Data1** TEMP_B11_B22 = scratch.keep(add(B11, B22, k));
+				Data1** TEMP_A12_A22 = scratch.keep(sub(A12, A22, k));
+				Data1** TEMP_B21_B22 = scratch.keep(add(B21, B22, k));
+				Data1** TEMP_A11_A21 = scratch.keep(sub(A11, A21, k));
+				Data1** TEMP_B11_B12 = scratch.keep(add(B11, B12, k));
+
+				Data1** X[7]={A11, TEMP_A11_A12, TEMP_A21_A22, A22, TEMP_A11_A22, TEMP_A12_A22, TEMP_A11_A21};
+				Data1** Y[7]={TEMP_B12_B22, B22, B11, TEMP_B21_B11, TEMP_B11_B22, TEMP_B21_B22, TEMP_B11_B12};
+				Data1** P[7]={NULL, NULL, NULL, NULL, NULL, NULL, NULL};
+				if(pool!=NULL && parallel_depth>0) // Compute the 7 coefficients as independent chunks of a parallel_for on the pool.
+				{
+					try{
+						parallel_for(*pool,0,7,[&](size_t lo, size_t hi){
+							for(size_t p=lo;p<hi;p++)
+							{
+								P[p]=StrassenMultiply(X[p], Y[p], k, pool, parallel_depth-1);
+							}
+						});
+					}catch (...)
+					{
+						for(Data1** M: P) // Every chunk is done once parallel_for throws, free the products that did succeed.
+						{
+							Free_matrix(M);
+						}
+						throw;
+					}
+					for(Data1** M: P)
+					{
+						scratch.keep(M);
+					}
+				}
+				else
+				{
+					for(int p=0;p<7;p++)
+					{
+						P[p]=scratch.keep(StrassenMultiply(X[p], Y[p], k));
+					}
+				}
+				Data1 **P1=P[0], **P2=P[1], **P3=P[2], **P4=P[3], **P5=P[4], **P6=P[5], **P7=P[6];
+
+				Data1** TEMP_P5_P4 = scratch.keep(add(P5, P4, k));
+				Data1** TEMP_P5_P4_P6 = scratch.keep(add(TEMP_P5_P4, P6, k));
+				Data1** TEMP_P5_P1 = scratch.keep(add(P5, P1, k));
+				Data1** TEMP_P5_P1_P3 = scratch.keep(sub(TEMP_P5_P1, P3, k));
+
+
+				Data1** C11 = scratch.keep(sub(TEMP_P5_P4_P6, P2, k));
+				Data1** C12 = scratch.keep(add(P1, P2, k));
+				Data1** C21 = scratch.keep(add(P3, P4, k));
+				Data1** C22 = scratch.keep(sub(TEMP_P5_P1_P3, P7, k));
+
+				// Building the returning C Matrix
+				Data1** C = Init_matrix(n); // Initialize an nxn matrix to store the result
+
+				for(size_t i=0; i<k; i++)
+				{
+					for(size_t j=0; j<k; j++)
+					{
+						C[i][j] = C11[i][j];
+						C[i][j+k] = C12[i][j];
+						C[k+i][j] = C21[i][j];
+						C[k+i][k+j] = C22[i][j];
+					}
+				}
+
+				return C; // The temporary Matrices are freed by scratch.
+			}
+
+			// Print Matrix (internal printing)
+			/**
+			 * @brief This function is called from within the MATOPS::BigMatrix<Data1>::matmul function when print == True
+			 * @param C Pointer to the memory where the array is stored.
+			 * @param m No of rows of the Matrix
+			 * @param n No of Columns of the Matrix
+			 */
+			void print_Mat(Data1** C, size_t m, size_t n)
+			{
+				for(size_t i=0;i<m;i++)
+				{
+					for(size_t j=0;j<n;j++)
+					{
+						std::cout<<C[i][j]<<" ";
+					}
+					std::cout<<'\n';
+				}
+			}
+
+			/**
+			 * @brief Overload of print_Mat for a Matrix held in a 2D vector.
+			 * @param C = 2D vector holding the Matrix
+			 */
+			void print_Mat(const std::vector<std::vector<Data1>> &C)
+			{
+				for(const std::vector<Data1> &row: C)
+				{
+					for(const Data1 &x: row)
+					{
+						std::cout<<x<<" ";
+					}
+					std::cout<<'\n';
+				}
+			}
+
+			/**
+			 * @brief Parse a CSV operand of MATOPS::BigMatrix<Data1>::matmul in the form it will be multiplied in. The non zeros are collected in COO
+			 * form while parsing and turned into CSR once the file is done. Only when the non zeros pass SPARSE_THRESHOLD x (rows x cols) (the shape is
+			 * read first with csv_shape) the rows parsed so far are densified and the rest of the file is parsed into the dense form, so a sparse
+			 * operand never exists as a dense Matrix and a dense operand never exists twice.
+			 * @param path = "path to A.csv"
+			 * @param S = Returns the Matrix in CSR form if it is sparse
+			 * @param MAT = Returns the Matrix in dense form otherwise
+			 * @param allow_sparse = false always returns the dense form
+			 * @return Returns true if the Matrix was returned in S. Throws std::runtime_error if the file doesn't exist.
+			 */
+			bool read_operand(const std::string &path, SparseMatrix<Data1> &S, std::vector<std::vector<Data1>> &MAT, bool allow_sparse=true)
+			{
+				if(!allow_sparse || SPARSE_THRESHOLD<=0)
+				{
+					MAT=read_CSV(path);
+					return false;
+				}
+				size_t rows, cols;
+				csv_shape(path,rows,cols);
+				const double max_nnz=SPARSE_THRESHOLD*(double)rows*(double)cols;
+
+				std::ifstream indata;
+				indata.open(path);
+				if(indata.fail())
+				{
+					throw std::runtime_error("File path: '"+path+"' doesn't exist");
+				}
+				std::vector<typename SparseMatrix<Data1>::Triplet> triplets;
+				bool sparse=true;
+				size_t i=0, n_cols=cols;
+				std::string line="";
+				MAT.clear();
+				while(getline(indata,line))
+				{
+					if(line.empty() || line=="\r")
+					{
+						continue;
+					}
+					std::stringstream lineStream(line);
+					std::string cell;
+					std::vector<Data1> row;
+					size_t j=0;
+					while(std::getline(lineStream,cell,','))
+					{
+						Data1 value=convert_to<Data1>(cell);
+						if(!sparse)
+						{
+							row.push_back(value);
+						}
+						else if(value!=Data1(0))
+						{
+							typename SparseMatrix<Data1>::Triplet t;
+							t.row=i;
+							t.col=j;
+							t.value=value;
+							triplets.push_back(t);
+						}
+						j++;
+					}
+					n_cols=std::max(n_cols,j);
+					if(sparse && triplets.size()>max_nnz) // Too dense: switch to the dense form for the rest of the file.
+					{
+						sparse=false;
+						MAT.assign(i+1,std::vector<Data1>(cols,Data1(0)));
+						for(const typename SparseMatrix<Data1>::Triplet &t: triplets)
+						{
+							if(t.col>=MAT[t.row].size())
+							{
+								MAT[t.row].resize(t.col+1,Data1(0));
+							}
+							MAT[t.row][t.col]=t.value;
+						}
+						std::vector<typename SparseMatrix<Data1>::Triplet>().swap(triplets);
+					}
+					else if(!sparse)
+					{
+						MAT.push_back(std::move(row));
+					}
+					i++;
+				}
+				indata.close();
+				if(sparse)
+				{
+					S=SparseMatrix<Data1>::from_triplets(i,n_cols,std::move(triplets));
+				}
+				return sparse;
+			}
+
+		// LOAD from CSV file Template
+			/**
+			 * @brief Function to parse a CSV file into a 2D vector. Unlike MATOPS::BigMatrix<Data1>::load_CSV it doesn't exit the program on failure, it throws a
+			 * std::runtime_error instead, so that callers running several jobs (e.g. MATOPS::BigMatrix<Data1>::matmul_batch) can report the error per job.
+			 * With enable_csv_index() the row offsets are collected while parsing and saved as the file's MATOPS::CsvIndex sidecar if it has none yet.
+			 * @param path= "path to CSV file i.e. to be loaded"
+			 * @return The Matrix loaded in memory as a 2D vector.
+			 */
+		std::vector<std::vector<Data1>> read_CSV(const std::string &path)
+		{
 		    std::ifstream indata;
 		    indata.open(path);
 
-		    if(indata.fail()) // Check if File exists
-		    {
-		    	std::cerr<<"File path: '"<<path<<"' doesn't exist\n";
-		    	exit(0);
-		    }
+		    if(indata.fail()) // Check if File exists
+		    {
+		    	throw std::runtime_error("File path: '"+path+"' doesn't exist");
+		    }
+
+		    std::vector<std::vector<Data1>> dataList;
+		    std::string line = "";
+
+		    CsvIndex existing;
+		    bool index=CSV_INDEX && !existing.load(path);
+		    std::vector<uint64_t> row_offsets;
+		    uint64_t position=0;
+
+		    while(getline(indata,line))
+		    {
+		        uint64_t start=position;
+		        position+=line.size()+1;
+		        if(line.empty() || line=="\r") // Blank lines are not rows, as in csv_shape and read_operand
+		        {
+		        	continue;
+		        }
+		        if(index)
+		        {
+		        	row_offsets.push_back(start);
+		        }
+		        std::stringstream lineStream(line);
+		        std::string cell;
+		        std::vector<Data1> temp;
+		        while (std::getline(lineStream,cell,','))
+		        {
+		            temp.push_back(convert_to<Data1>(cell)); // convert from string to Data1 and store it in an 2D array.
+		        }
+		        dataList.push_back(temp);
+
+		    }
+		    indata.close(); // Close file
+		    if(index && !row_offsets.empty())
+		    {
+		    	CsvIndex(path,std::move(row_offsets),dataList[0].size()).save();
+		    }
+		    return dataList; // Return the 2D vector 
+		}
+
+			/**
+			 * @brief Function to load CSV file. This function is internally called by  MATOPS::BigMatrix<Data1>::matmul  and  MATOPS::BigMatrix< Data1 >::Transpose 
+			 * to load the BigMatrix's to be multiplied or Transposed. It throws an error if path is invalid or CSV doesn't exist.
+			 * @param path= "path to CSV file i.e. to be loaded"
+			 * @return A pointer to the Matrix loaded in memory.
+			 */
+		std::vector<std::vector<Data1>> load_CSV(const std::string &path)
+		{
+			try{
+				return read_CSV(path);
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+		}
+
+			/**
+			 * @brief Function to free a matrix allocated by MATOPS::BigMatrix<Data1>::Init_matrix.
+			 * @param M = Pointer returned by Init_matrix
+			 */
+			void Free_matrix(Data1** M)
+			{
+				huge_free(M);
+			}
+
+			/**
+			 * @brief Multiply two Matrices that are already loaded in memory. This is the compute part of MATOPS::BigMatrix<Data1>::matmul without any
+			 * file I/O: both matrices are zero padded to a dim_n x dim_n square (dim_n = next power of 2) and handed to StrassenMultiply.
+			 * @param MAT_1 = Matrix A (m_1 x n_1)
+			 * @param MAT_2 = Matrix B (n_1 x n_2)
+			 * @param dim_n = Returns the size of the padded result
+			 * @return Pointer to the padded dim_n x dim_n result, to be freed with Free_matrix. The product is stored in its top left m_1 x n_2 block.
+			 */
+			Data1** multiply_padded(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, size_t &dim_n)
+			{
+				size_t m_1=MAT_1.size(), n_1=MAT_1[0].size();
+				size_t m_2=MAT_2.size(), n_2=MAT_2[0].size();
+
+				size_t max_n= std::max(std::max(m_1,n_1),n_2);
+				dim_n=1;
+				while(dim_n<max_n)
+				{
+					dim_n=dim_n<<1;
+				}
+
+				Data1** A=Init_matrix(dim_n);
+				Data1** B=Init_matrix(dim_n);
+				for(size_t k=0;k<m_1;k++)
+				{
+					for(size_t l=0;l<n_1;l++)
+					{
+						A[k][l]= MAT_1[k][l];
+					}
+				}
+				for(size_t k=0;k<m_2;k++)
+				{
+					for(size_t l=0;l<n_2;l++)
+					{
+						B[k][l]= MAT_2[k][l];
+					}
+				}
+
+				Data1** C=StrassenMultiply(A, B, dim_n);
+				Free_matrix(A);
+				Free_matrix(B);
+				return C;
+			}
+
+			/**
+			 * @brief A pair of padded square buffers that is reused by consecutive products of a chain instead of allocating new padded operands for every
+			 * step. StrassenMultiply only touches the top left n x n block of its inputs, so a buffer can serve any product with dim_n <= capacity.
+			 */
+			struct PadBuffers
+			{
+				Data1** A=NULL;
+				Data1** B=NULL;
+				size_t capacity=0;
+			};
+
+			/**
+			 * @brief Free the buffers of a PadBuffers pair.
+			 */
+			void Free_pad_buffers(PadBuffers &buffers)
+			{
+				if(buffers.capacity>0)
+				{
+					Free_matrix(buffers.A);
+					Free_matrix(buffers.B);
+				}
+				buffers=PadBuffers();
+			}
+
+			/**
+			 * @brief Copy MAT (or its transpose) into the top left corner of the padded buffer P and zero the rest of its dim_n x dim_n block.
+			 * @param transposed = Copy the transpose of MAT. The transpose is done in 32 x 32 tiles while packing, it is never materialized separately.
+			 */
+			void pad_into(Data1** P, const std::vector<std::vector<Data1>> &MAT, size_t dim_n, bool transposed=false)
+			{
+				if(transposed)
+				{
+					size_t m=MAT[0].size(), n=MAT.size(); // Dimensions of the transpose
+					for(size_t i=0;i<dim_n;i++)
+					{
+						std::fill(P[i],P[i]+dim_n,Data1(0));
+					}
+					const size_t TILE=32;
+					for(size_t jj=0;jj<n;jj+=TILE)
+					{
+						for(size_t ii=0;ii<m;ii+=TILE)
+						{
+							for(size_t j=jj;j<std::min(n,jj+TILE);j++)
+							{
+								for(size_t i=ii;i<std::min(m,ii+TILE);i++)
+								{
+									P[i][j]=MAT[j][i];
+								}
+							}
+						}
+					}
+					return;
+				}
+				size_t m=MAT.size(), n=MAT[0].size();
+				for(size_t i=0;i<dim_n;i++)
+				{
+					size_t j=0;
+					if(i<m)
+					{
+						for(;j<n;j++)
+						{
+							P[i][j]=MAT[i][j];
+						}
+					}
+					std::fill(P[i]+j,P[i]+dim_n,Data1(0));
+				}
+			}
+
+			/**
+			 * @brief Estimated no. of multiply-adds of StrassenMultiply on a dim_n x dim_n product with the current LEAF_SIZE,
+			 * i.e. S(n) = 7 S(n/2) + 18 (n/2)^2 with S(n) = n^3 for n <= LEAF_SIZE.
+			 */
+			double strassen_cost(size_t dim_n)
+			{
+				if(dim_n<=(size_t)LEAF_SIZE)
+				{
+					return (double)dim_n*dim_n*dim_n;
+				}
+				double k=dim_n/2;
+				return 7*strassen_cost(dim_n/2)+18*k*k;
+			}
+
+			/**
+			 * @brief Estimated cost of an m x n by n x p product: the cheaper of the classical O(n^3) product and Strassen's Algorithm on the padded operands.
+			 * @param strassen = Returns true if Strassen's Algorithm is the cheaper one
+			 */
+			double product_cost(size_t m, size_t n, size_t p, bool &strassen)
+			{
+				size_t dim_n=1;
+				while(dim_n<std::max(std::max(m,n),p))
+				{
+					dim_n=dim_n<<1;
+				}
+				double classical=(double)m*n*p;
+				double fast=strassen_cost(dim_n);
+				strassen=fast<classical;
+				return std::min(classical,fast);
+			}
+
+			/**
+			 * @brief Multiply two in-memory Matrices with whichever of the classical product and Strassen's Algorithm product_cost() picks. The Strassen
+			 * operands are padded into buffers, which are grown when needed and reused otherwise.
+			 * @param pool, parallel_depth = Optional pool for the parallel StrassenMultiply path
+			 * @return The exact m x p product as a 2D vector.
+			 */
+			std::vector<std::vector<Data1>> multiply_step(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, PadBuffers &buffers,
+					ThreadPool* pool=NULL, int parallel_depth=0)
+			{
+				size_t m=MAT_1.size(), n=MAT_2.size(), p=MAT_2[0].size();
+				std::vector<std::vector<Data1>> C(m,std::vector<Data1>(p,Data1(0)));
+				bool strassen;
+				product_cost(m,n,p,strassen);
+				if(!strassen)
+				{
+					for(size_t i=0;i<m;i++) // i-k-j order keeps the inner loop contiguous
+					{
+						for(size_t k=0;k<n;k++)
+						{
+							const Data1 a=MAT_1[i][k];
+							const Data1* b=MAT_2[k].data();
+							Data1* c=C[i].data();
+							for(size_t j=0;j<p;j++)
+							{
+								c[j]+=a*b[j];
+							}
+						}
+					}
+					return C;
+				}
+
+				size_t dim_n=1;
+				while(dim_n<std::max(std::max(m,n),p))
+				{
+					dim_n=dim_n<<1;
+				}
+				if(dim_n>buffers.capacity)
+				{
+					Free_pad_buffers(buffers);
+					buffers.A=Init_matrix(dim_n);
+					buffers.B=Init_matrix(dim_n);
+					buffers.capacity=dim_n;
+				}
+				pad_into(buffers.A,MAT_1,dim_n);
+				pad_into(buffers.B,MAT_2,dim_n);
+				Data1** P=StrassenMultiply(buffers.A,buffers.B,dim_n,pool,parallel_depth);
+				for(size_t i=0;i<m;i++)
+				{
+					std::copy(P[i],P[i]+p,C[i].begin());
+				}
+				Free_matrix(P);
+				return C;
+			}
+
+			/**
+			 * @brief Optimal parenthesization of a Matrix chain by dynamic programming over the cost of product_cost().
+			 * @param dims = Chain dimensions, Matrix i is dims[i] x dims[i+1]
+			 * @return split[i][j] = index k at which the product of Matrices i..j is split into (i..k)(k+1..j).
+			 */
+			std::vector<std::vector<int>> chain_order(const std::vector<size_t> &dims)
+			{
+				int N=dims.size()-1;
+				std::vector<std::vector<double>> cost(N,std::vector<double>(N,0));
+				std::vector<std::vector<int>> split(N,std::vector<int>(N,0));
+				for(int len=2;len<=N;len++)
+				{
+					for(int i=0;i+len-1<N;i++)
+					{
+						int j=i+len-1;
+						cost[i][j]=-1;
+						for(int k=i;k<j;k++)
+						{
+							bool strassen;
+							double c=cost[i][k]+cost[k+1][j]+product_cost(dims[i],dims[k+1],dims[j+1],strassen);
+							if(cost[i][j]<0 || c<cost[i][j])
+							{
+								cost[i][j]=c;
+								split[i][j]=k;
+							}
+						}
+					}
+				}
+				return split;
+			}
+
+			/**
+			 * @brief Evaluate the product of Matrices i..j of a chain following the split table of chain_order(). Leaves are fetched through operand(i)
+			 * only when they are needed and every intermediate is released as soon as it has been consumed.
+			 */
+			std::vector<std::vector<Data1>> evaluate_chain(const std::vector<std::vector<int>> &split, int i, int j,
+					const std::function<std::vector<std::vector<Data1>>(int)> &operand, PadBuffers &buffers)
+			{
+				if(i==j)
+				{
+					return operand(i);
+				}
+				int k=split[i][j];
+				std::vector<std::vector<Data1>> left=evaluate_chain(split,i,k,operand,buffers);
+				std::vector<std::vector<Data1>> right=evaluate_chain(split,k+1,j,operand,buffers);
+				return multiply_step(left,right,buffers);
+			}
+
+			/**
+			 * @brief A fused element-wise expression out = alpha * X + beta * (Y o Z), optionally clamped to [lo, hi]. X, Y and Z are optional, a missing
+			 * Z drops the Hadamard product (beta * Y) and a missing Y drops the whole second term.
+			 */
+			struct Expression
+			{
+				Data1 alpha=Data1(1);
+				Data1 beta=Data1(0);
+				bool clamp=false;
+				Data1 lo=Data1(0), hi=Data1(0);
+			};
+
+			/**
+			 * @brief Evaluate an Expression on n contiguous elements. Every combination of operands has its own loop without branches, so the compiler can
+			 * vectorize it; the clamp runs over the output while it is still in the cache.
+			 */
+			static void apply(const Expression &e, const Data1* x, const Data1* y, const Data1* z, Data1* out, size_t n)
+			{
+				const Data1 alpha=e.alpha, beta=e.beta;
+				if(x!=NULL && y!=NULL && z!=NULL)
+				{
+					for(size_t j=0;j<n;j++) out[j]=alpha*x[j]+beta*y[j]*z[j];
+				}
+				else if(x!=NULL && y!=NULL)
+				{
+					for(size_t j=0;j<n;j++) out[j]=alpha*x[j]+beta*y[j];
+				}
+				else if(x!=NULL)
+				{
+					for(size_t j=0;j<n;j++) out[j]=alpha*x[j];
+				}
+				else if(y!=NULL && z!=NULL)
+				{
+					for(size_t j=0;j<n;j++) out[j]=beta*y[j]*z[j];
+				}
+				else if(y!=NULL)
+				{
+					for(size_t j=0;j<n;j++) out[j]=beta*y[j];
+				}
+				else
+				{
+					std::fill(out,out+n,Data1(0));
+				}
+				if(e.clamp)
+				{
+					const Data1 lo=e.lo, hi=e.hi;
+					for(size_t j=0;j<n;j++) out[j]= (out[j]<lo)? lo : ((out[j]>hi)? hi : out[j]);
+				}
+			}
+
+			/**
+			 * @brief Evaluate an Expression on in-memory Matrices, the rows are split over pool. Operands that are NULL are left out.
+			 * @return The result. Throws std::invalid_argument if the given operands don't have the same shape or Z is given without Y.
+			 */
+			std::vector<std::vector<Data1>> evaluate(const Expression &e, const std::vector<std::vector<Data1>>* X, const std::vector<std::vector<Data1>>* Y,
+					const std::vector<std::vector<Data1>>* Z, ThreadPool &pool)
+			{
+				if(Z!=NULL && Y==NULL)
+				{
+					throw std::invalid_argument("The Hadamard product needs both B and C, C was given without B");
+				}
+				const std::vector<std::vector<Data1>>* shape= (X!=NULL)? X : Y;
+				for(const std::vector<std::vector<Data1>>* M: {X,Y,Z})
+				{
+					if(M!=NULL && (M->size()!=shape->size() || (!M->empty() && (*M)[0].size()!=(*shape)[0].size())))
+					{
+						throw std::invalid_argument("Matrix Dimensions don't match !!!");
+					}
+				}
+				std::vector<std::vector<Data1>> OUT(shape->size());
+				parallel_for(pool,0,OUT.size(),[&](size_t lo, size_t hi){
+					for(size_t i=lo;i<hi;i++)
+					{
+						size_t n=(*shape)[i].size();
+						if((Y!=NULL && (*Y)[i].size()!=n) || (Z!=NULL && (*Z)[i].size()!=n))
+						{
+							throw std::invalid_argument("Matrix Dimensions don't match !!!");
+						}
+						OUT[i].resize(n);
+						apply(e,(X!=NULL)? (*X)[i].data() : NULL,(Y!=NULL)? (*Y)[i].data() : NULL,(Z!=NULL)? (*Z)[i].data() : NULL,OUT[i].data(),n);
+					}
+				});
+				return OUT;
+			}
+
+			/**
+			 * @brief Overload of evaluate that runs on its own MATOPS::ThreadPool of n_threads workers.
+			 */
+			std::vector<std::vector<Data1>> evaluate(const Expression &e, const std::vector<std::vector<Data1>>* X, const std::vector<std::vector<Data1>>* Y,
+					const std::vector<std::vector<Data1>>* Z, size_t n_threads)
+			{
+				ThreadPool pool(n_threads);
+				return evaluate(e,X,Y,Z,pool);
+			}
+
+			/**
+			 * @brief Read the next stripe of at most stripe non blank lines of a csv file.
+			 * @return Returns false once the end of the file was reached.
+			 */
+			static bool read_stripe(std::ifstream &indata, std::vector<std::string> &lines, size_t stripe=STREAM_STRIPE)
+			{
+				lines.clear();
+				lines.reserve(stripe);
+				std::string line="";
+				bool more=true;
+				while(lines.size()<stripe && (more=static_cast<bool>(getline(indata,line))))
+				{
+					if(!line.empty() && line!="\r")
+					{
+						lines.push_back(line);
+					}
+				}
+				return more;
+			}
+
+			/**
+			 * @brief The streaming loop shared by stream_evaluate, stream_reduce and matmul_gemv. next(stripe, more) reads the next stripe of the
+			 * input and sets more to false at the end of the input (it returns false if the stripe is empty), run(stripe) is submitted to pool for
+			 * every stripe and consume(result) receives the results in input order. At most 2 stripes per worker are in flight.
+			 * If anything throws, the stripes still in flight are waited for before the exception is rethrown, so run may safely reference the
+			 * caller's locals.
+			 */
+			template<typename Stripe, typename Next, typename Run, typename Consume>
+			static void stream_stripes(ThreadPool &pool, Next next, Run run, Consume consume)
+			{
+				typedef decltype(run(std::declval<Stripe>())) Result;
+				std::queue<std::future<Result>> in_flight;
+				try{
+					bool more=true;
+					while(more)
+					{
+						Stripe stripe;
+						if(next(stripe,more))
+						{
+							in_flight.push(pool.submit(std::bind(run,std::move(stripe))));
+						}
+						while(!in_flight.empty() && (!more || in_flight.size()>=2*pool.size()))
+						{
+							std::future<Result> done=std::move(in_flight.front());
+							in_flight.pop();
+							consume(done.get());
+						}
+					}
+				}catch (...)
+				{
+					for(;!in_flight.empty();in_flight.pop())
+					{
+						in_flight.front().wait();
+					}
+					throw;
+				}
+			}
+
+			/**
+			 * @brief Parse one csv line into row.
+			 */
+			static void parse_row(const std::string &line, std::vector<Data1> &row)
+			{
+				row.clear();
+				std::stringstream lineStream(line);
+				std::string cell;
+				while(std::getline(lineStream,cell,','))
+				{
+					row.push_back(convert_to<Data1>(cell));
+				}
+			}
+
+			/**
+			 * @brief Evaluate an Expression on csv files (X, Y and Z may be "" to leave them out, Z only together with Y) and write the result to path in one streaming pass: the
+			 * files are read in lockstep in stripes of STREAM_STRIPE rows, every stripe is parsed, evaluated and formatted by a task on a
+			 * MATOPS::ThreadPool and the finished stripes are written in order. At most 2 stripes per thread are held in memory.
+			 */
+			void stream_evaluate(const Expression &e, const std::string &file_X, const std::string &file_Y, const std::string &file_Z, const std::string &path,
+					size_t n_threads)
+			{
+				if(!file_Z.empty() && file_Y.empty())
+				{
+					std::cerr<<"The Hadamard product needs both B and C, C was given without B\n";
+					exit(0);
+				}
+				// slot[0], slot[1] and slot[2] are the input indices of X, Y and Z, or -1 for an operand that is left out.
+				std::vector<std::string> files;
+				int slot[3];
+				const std::string* operands[3]={&file_X,&file_Y,&file_Z};
+				for(int k=0;k<3;k++)
+				{
+					slot[k]=-1;
+					if(!operands[k]->empty())
+					{
+						slot[k]=(int)files.size();
+						files.push_back(*operands[k]);
+					}
+				}
+				std::vector<std::ifstream> inputs(files.size());
+				for(size_t f=0;f<files.size();f++)
+				{
+					inputs[f].open(files[f]);
+					if(inputs[f].fail())
+					{
+						std::cerr<<"File path: '"<<files[f]<<"' doesn't exist\n";
+						exit(0);
+					}
+				}
+				std::ofstream file;
+				file.open(path);
+				if(file.fail())
+				{
+					std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+					exit(0);
+				}
+
+				// Parse and evaluate one stripe of every input, returns the csv text of the matching rows of the result.
+				auto run_stripe=[&e,slot](std::vector<std::vector<std::string>> stripes){
+					std::ostringstream out;
+					std::vector<std::vector<Data1>> rows(stripes.size());
+					std::vector<Data1> result;
+					for(size_t i=0;i<stripes[0].size();i++)
+					{
+						for(size_t f=0;f<stripes.size();f++)
+						{
+							parse_row(stripes[f][i],rows[f]);
+							if(rows[f].size()!=rows[0].size())
+							{
+								throw std::runtime_error("Matrix Dimensions don't match !!!");
+							}
+						}
+						size_t n=rows[0].size();
+						const Data1* operand[3];
+						for(int k=0;k<3;k++)
+						{
+							operand[k]=(slot[k]<0)? NULL : rows[slot[k]].data();
+						}
+						result.resize(n);
+						apply(e,operand[0],operand[1],operand[2],result.data(),n);
+						for(size_t j=0;j<n;j++)
+						{
+							out<<result[j]<<((j+1<n)? ",":"\n");
+						}
+					}
+					return out.str();
+				};
+
+				// Read the next stripe of every input in lockstep. Every input has to reach its end together with the first one, so extra rows at
+				// the end of the second or third operand are an error instead of being dropped.
+				auto next_stripe=[&inputs](std::vector<std::vector<std::string>> &stripes, bool &more){
+					stripes.resize(inputs.size());
+					more=read_stripe(inputs[0],stripes[0]);
+					for(size_t f=1;f<inputs.size();f++)
+					{
+						bool more_input=read_stripe(inputs[f],stripes[f]);
+						if(stripes[f].size()!=stripes[0].size() || more_input!=more)
+						{
+							throw std::runtime_error("Matrix Dimensions don't match !!!");
+						}
+					}
+					return !stripes[0].empty();
+				};
+
+				try{
+					ThreadPool pool(n_threads);
+					stream_stripes<std::vector<std::vector<std::string>>>(pool,next_stripe,run_stripe,[&file](const std::string &text){
+						file<<text;
+					});
+				}catch (const std::runtime_error &err)
+				{
+					std::cerr<<err.what()<<'\n';
+					exit(0);
+				}
+				file.close();
+				if(file.fail())
+				{
+					std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+					exit(0);
+				}
+			}
+
+			/**
+			 * @brief Reduce a csv file in one streaming pass: every stripe of STREAM_STRIPE rows is parsed and reduced to a partial result by a task on a
+			 * MATOPS::ThreadPool with reduce(row, n), and the partials are combined in file order with combine(total, partial).
+			 */
+			template<typename F, typename G>
+			double stream_reduce(const std::string &path, double init, F reduce, G combine, size_t n_threads)
+			{
+				std::ifstream indata;
+				indata.open(path);
+				if(indata.fail())
+				{
+					std::cerr<<"File path: '"<<path<<"' doesn't exist\n";
+					exit(0);
+				}
+				auto run_stripe=[init,&reduce,&combine](std::vector<std::string> lines){
+					double partial=init;
+					std::vector<Data1> row;
+					for(const std::string &line: lines)
+					{
+						parse_row(line,row);
+						partial=combine(partial,reduce(row.data(),row.size()));
+					}
+					return partial;
+				};
+				double total=init;
+				{
+					ThreadPool pool(n_threads);
+					stream_stripes<std::vector<std::string>>(pool,[&indata](std::vector<std::string> &lines, bool &more){
+						more=read_stripe(indata,lines);
+						return !lines.empty();
+					},run_stripe,[&total,&combine](double partial){
+						total=combine(total,partial);
+					});
+				}
+				indata.close();
+				return total;
+			}
+
+			/**
+			 * @brief Sum of the elements of a row, accumulated in double with 4 independent accumulators.
+			 */
+			static double row_sum(const Data1* x, size_t n)
+			{
+				double s[4]={0,0,0,0};
+				size_t j=0;
+				for(;j+4<=n;j+=4)
+				{
+					s[0]+=(double)x[j]; s[1]+=(double)x[j+1]; s[2]+=(double)x[j+2]; s[3]+=(double)x[j+3];
+				}
+				for(;j<n;j++)
+				{
+					s[0]+=(double)x[j];
+				}
+				return (s[0]+s[1])+(s[2]+s[3]);
+			}
+
+			/**
+			 * @brief Sum of the squares of the elements of a row, accumulated in double with 4 independent accumulators.
+			 */
+			static double row_sum_squares(const Data1* x, size_t n)
+			{
+				double s[4]={0,0,0,0};
+				size_t j=0;
+				for(;j+4<=n;j+=4)
+				{
+					for(int l=0;l<4;l++)
+					{
+						double v=(double)x[j+l];
+						s[l]+=v*v;
+					}
+				}
+				for(;j<n;j++)
+				{
+					s[0]+=(double)x[j]*(double)x[j];
+				}
+				return (s[0]+s[1])+(s[2]+s[3]);
+			}
+
+			/**
+			 * @brief Largest absolute value of the elements of a row.
+			 */
+			static double row_max_abs(const Data1* x, size_t n)
+			{
+				double m=0;
+				for(size_t j=0;j<n;j++)
+				{
+					m=std::max(m,std::fabs((double)x[j]));
+				}
+				return m;
+			}
+
+			/**
+			 * @brief Product X x Y for the block updates of the LU factorization and the triangular solves, through multiply_step (i.e. StrassenMultiply
+			 * when it is cheaper) with the 7 Strassen products of the top recursion levels running on the pool.
+			 */
+			std::vector<std::vector<Data1>> block_product(const std::vector<std::vector<Data1>> &X, const std::vector<std::vector<Data1>> &Y,
+					PadBuffers &buffers, ThreadPool &pool)
+			{
+				int parallel_depth=(pool.size()>1)? ((pool.size()>7)? 2 : 1) : 0;
+				return multiply_step(X,Y,buffers,&pool,parallel_depth);
+			}
+
+			/**
+			 * @brief Copy of the block rows [r0, r1) x cols [c0, c1) of M.
+			 */
+			static std::vector<std::vector<Data1>> block(const std::vector<std::vector<Data1>> &M, size_t r0, size_t r1, size_t c0, size_t c1)
+			{
+				std::vector<std::vector<Data1>> X(r1-r0);
+				for(size_t i=r0;i<r1;i++)
+				{
+					X[i-r0].assign(M[i].begin()+c0,M[i].begin()+c1);
+				}
+				return X;
+			}
+
+			/**
+			 * @brief Solve T X = B for X in place of the rows [b0, b0+n) of B, where T is the n x n triangular block of M starting at the diagonal
+			 * element (t0, t0). Recursive on halves of T: the off diagonal block is applied to all the right hand sides at once with block_product.
+			 * @param lower = T is lower (forward substitution) or upper (back substitution) triangular
+			 * @param unit = T has an implicit unit diagonal (the L of an LU factorization)
+			 */
+			void triangular_block_solve(const std::vector<std::vector<Data1>> &M, size_t t0, size_t n, std::vector<std::vector<Data1>> &B, size_t b0,
+					bool lower, bool unit, PadBuffers &buffers, ThreadPool &pool)
+			{
+				size_t r=B.empty()? 0 : B[0].size();
+				if(n<=LU_LEAF)
+				{
+					for(size_t s=0;s<n;s++)
+					{
+						size_t i= lower? s : n-1-s;
+						Data1* x=B[b0+i].data();
+						size_t k_begin= lower? 0 : i+1, k_end= lower? i : n;
+						for(size_t k=k_begin;k<k_end;k++) // Row axpy over all the right hand sides
+						{
+							const Data1 t=M[t0+i][t0+k];
+							const Data1* y=B[b0+k].data();
+							for(size_t j=0;j<r;j++)
+							{
+								x[j]-=t*y[j];
+							}
+						}
+						if(!unit)
+						{
+							const Data1 d=M[t0+i][t0+i];
+							for(size_t j=0;j<r;j++)
+							{
+								x[j]/=d;
+							}
+						}
+					}
+					return;
+				}
+				size_t n1=n/2;
+				// lower: X1 = T11^-1 B1, B2 -= T21 X1, X2 = T22^-1 B2. upper: X2 = T22^-1 B2, B1 -= T12 X2, X1 = T11^-1 B1.
+				size_t first= lower? 0 : n1, first_n= lower? n1 : n-n1;
+				size_t second= lower? n1 : 0, second_n= lower? n-n1 : n1;
+				triangular_block_solve(M,t0+first,first_n,B,b0+first,lower,unit,buffers,pool);
+				std::vector<std::vector<Data1>> P=block_product(block(M,t0+second,t0+second+second_n,t0+first,t0+first+first_n),
+						block(B,b0+first,b0+first+first_n,0,r),buffers,pool);
+				for(size_t i=0;i<second_n;i++)
+				{
+					Data1* x=B[b0+second+i].data();
+					for(size_t j=0;j<r;j++)
+					{
+						x[j]-=P[i][j];
+					}
+				}
+				triangular_block_solve(M,t0+second,second_n,B,b0+second,lower,unit,buffers,pool);
+			}
+
+			/**
+			 * @brief Recursive LU factorization with partial pivoting of the panel made of rows [c0, N) and cols [c0, c0+n) of the N x N Matrix A, in place
+			 * (L below the diagonal with an implicit unit diagonal, U on and above it). Pivoting swaps whole rows of A (and perm), so the swaps are applied
+			 * to the already factored columns on the left and to the columns on the right in O(1).
+			 *
+			 * The panel is split into a left and a right half of columns: the left half is factored recursively, the top right block is solved with the
+			 * unit lower triangle of the left half, the Schur complement A22 -= A21 x A12 is computed with block_product (Strassen's Algorithm) and is then
+			 * factored recursively. Throws std::runtime_error if the Matrix is singular.
+			 */
+			void lu_panel(std::vector<std::vector<Data1>> &A, size_t c0, size_t n, std::vector<size_t> &perm, PadBuffers &buffers, ThreadPool &pool)
+			{
+				size_t N=A.size();
+				if(n<=LU_LEAF)
+				{
+					for(size_t j=c0;j<c0+n;j++)
+					{
+						size_t p=j;
+						for(size_t i=j+1;i<N;i++)
+						{
+							if(std::fabs(A[i][j])>std::fabs(A[p][j]))
+							{
+								p=i;
+							}
+						}
+						if(A[p][j]==Data1(0))
+						{
+							throw std::runtime_error("Matrix is singular !!!");
+						}
+						std::swap(A[j],A[p]);
+						std::swap(perm[j],perm[p]);
+						const Data1* pivot_row=A[j].data();
+						for(size_t i=j+1;i<N;i++)
+						{
+							Data1* row=A[i].data();
+							const Data1 l=(row[j]/=pivot_row[j]);
+							for(size_t c=j+1;c<c0+n;c++)
+							{
+								row[c]-=l*pivot_row[c];
+							}
+						}
+					}
+					return;
+				}
+				size_t n1=n/2, c1=c0+n1, c2=c0+n;
+				lu_panel(A,c0,n1,perm,buffers,pool);
+
+				std::vector<std::vector<Data1>> A12=block(A,c0,c1,c1,c2);
+				triangular_block_solve(A,c0,n1,A12,0,true,true,buffers,pool);
+				for(size_t i=0;i<n1;i++)
+				{
+					std::copy(A12[i].begin(),A12[i].end(),A[c0+i].begin()+c1);
+				}
+				if(c1<N)
+				{
+					std::vector<std::vector<Data1>> S=block_product(block(A,c1,N,c0,c1),A12,buffers,pool);
+					for(size_t i=c1;i<N;i++)
+					{
+						Data1* row=A[i].data()+c1;
+						const Data1* s=S[i-c1].data();
+						for(size_t j=0;j<c2-c1;j++)
+						{
+							row[j]-=s[j];
+						}
+					}
+				}
+				lu_panel(A,c1,n-n1,perm,buffers,pool);
+			}
+
+			/**
+			 * @brief Recompute the whole product C = A x B kept by the incremental updates (see MATOPS::BigMatrix<Data1>::make_product).
+			 */
+			void recompute(const std::vector<std::vector<Data1>> &A, const std::vector<std::vector<Data1>> &B, std::vector<std::vector<Data1>> &C)
+			{
+				#ifndef SET_LEAF_SIZE
+					set_configerd_Leaf_size();
+				#endif
+				PadBuffers buffers;
+				C=multiply_step(A,B,buffers);
+				Free_pad_buffers(buffers);
+			}
+
+			/**
+			 * @brief Recompute some rows of C = A x B: row targets[c] of C becomes rows_A[c] x B (row i of C only depends on row i of A).
+			 */
+			void multiply_rows(const std::vector<size_t> &targets, const std::vector<const std::vector<Data1>*> &rows_A, const std::vector<std::vector<Data1>> &B,
+					std::vector<std::vector<Data1>> &C, size_t n_threads)
+			{
+				size_t k=B.size(), n=B.empty()? 0 : B[0].size();
+				ThreadPool pool(n_threads);
+				parallel_for(pool,0,targets.size(),[&](size_t lo, size_t hi){
+					for(size_t c=lo;c<hi;c++)
+					{
+						const std::vector<Data1> &a=*rows_A[c];
+						Data1* row=C[targets[c]].data();
+						std::fill(row,row+n,Data1(0));
+						for(size_t l=0;l<k;l++) // i-k-j order keeps the inner loop contiguous
+						{
+							const Data1* b=B[l].data();
+							for(size_t j=0;j<n;j++)
+							{
+								row[j]+=a[l]*b[j];
+							}
+						}
+					}
+				});
+			}
+
+			/**
+			 * @brief Parse rows [row_begin,row_end) and cols [col_begin,col_end) of an open csv file, seeking to the rows with its index.
+			 * @param indata = The csv file, opened in binary mode
+			 * @param index = Row offset index of the file
+			 */
+			std::vector<std::vector<Data1>> read_rows(std::ifstream &indata, const CsvIndex &index, size_t row_begin, size_t row_end, size_t col_begin, size_t col_end)
+			{
+				std::vector<std::vector<Data1>> MAT;
+				if(row_begin==row_end)
+				{
+					return MAT;
+				}
+				uint64_t begin=index.row_offset(row_begin), end=index.row_offset(row_end);
+				std::string bytes(end-begin,'\0');
+				indata.clear();
+				indata.seekg(begin);
+				indata.read(&bytes[0],bytes.size());
+
+				MAT.reserve(row_end-row_begin);
+				size_t line_start=0;
+				while(line_start<bytes.size() && MAT.size()<row_end-row_begin)
+				{
+					size_t line_end=bytes.find_first_of("\r\n",line_start);
+					if(line_end==std::string::npos)
+					{
+						line_end=bytes.size();
+					}
+					if(line_end>line_start) // Skip empty lines, the index doesn't count them
+					{
+						std::vector<Data1> row;
+						row.reserve(col_end-col_begin);
+						size_t cell_start=line_start;
+						for(size_t j=0;j<col_end && cell_start<=line_end;j++)
+						{
+							size_t cell_end=bytes.find(',',cell_start);
+							if(cell_end==std::string::npos || cell_end>line_end)
+							{
+								cell_end=line_end;
+							}
+							if(j>=col_begin)
+							{
+								row.push_back(convert_to<Data1>(bytes.substr(cell_start,cell_end-cell_start)));
+							}
+							cell_start=cell_end+1;
+						}
+						MAT.push_back(row);
+					}
+					line_start=line_end+1;
+				}
+				return MAT;
+			}
+
+			/**
+			 * @brief Everything besides the input files that the result of an operation depends on, used as part of the cache key.
+			 */
+			std::string cache_params()
+			{
+				std::ostringstream params;
+				params<<typeid(Data1).name()<<" "<<LEAF_SIZE<<" "<<SPARSE_THRESHOLD<<" "<<(int)QUANTIZATION<<" "<<GEMV_MAX_COLS;
+				return params.str();
+			}
+
+			/**
+			 * @brief Run compute() (which stores its result at path) through the result cache: on a hit the cached result is copied to path, on a miss
+			 * compute() runs and its result is added to the cache. Without a cache compute() simply runs.
+			 */
+			template<typename F>
+			void cached(const std::string &operation, const std::vector<std::string> &inputs, const std::string &path, F compute)
+			{
+				if(!CACHE)
+				{
+					compute();
+					return;
+				}
+				std::string key;
+				try{
+					key=CACHE->key(operation,inputs,cache_params());
+				}catch (const std::filesystem::filesystem_error &)
+				{
+					compute(); // Missing input, let the operation report it.
+					return;
+				}
+				if(CACHE->fetch(key,path))
+				{
+					return;
+				}
+				compute();
+				CACHE->store(key,path);
+			}
+
+		/**
+		 * @brief Function to print a Matrix from a .csv file.
+		 * @param path = "path to .csv i.e. to be printed"
+		 */
+			public:
+		void Mat_print(std::string path)
+		{
+			std::vector<std::vector<Data1>> MAT= load_CSV(path);
+
+			for(std::vector<Data1> a: MAT)
+			{
+				for(Data1 i: a)
+				{
+					std::cout<< i <<" ";
+				}
+				std::cout<<'\n';
+			}
+		}
+
+		/**
+		 * @brief Function to print a bounded preview of a Matrix stored in a .csv file: the top left max_rows x max_cols block followed by the shape of the
+		 * whole Matrix. Only the previewed rows are parsed, the shape comes from the row offset index (MATOPS::CsvIndex).
+		 * @param path = "path to .csv i.e. to be printed"
+		 * @param max_rows = Max. No. of Rows to print
+		 * @param max_cols = Max. No. of Columns to print
+		 */
+		void Mat_print(std::string path, size_t max_rows, size_t max_cols)
+		{
+			CsvIndex index;
+			std::vector<std::vector<Data1>> MAT;
+			try{
+				index=CsvIndex::open(path);
+				MAT=load_submatrix(path,0,std::min(max_rows,index.rows()),0,std::min(max_cols,index.cols()));
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+
+			for(const std::vector<Data1> &a: MAT)
+			{
+				for(const Data1 &i: a)
+				{
+					std::cout<< i <<" ";
+				}
+				std::cout<<((index.cols()>max_cols)? "...\n" : "\n");
+			}
+			if(index.rows()>max_rows)
+			{
+				std::cout<<"...\n";
+			}
+			std::cout<<"["<<index.rows()<<" x "<<index.cols()<<"]\n";
+		}
+
+		/**
+		 * @brief Function to get the row offset index of a .csv file. The "<path>.idx" sidecar is used when it is up to date, otherwise the index is built
+		 * with one pass over the file and saved.
+		 * @param path = "path to A.csv"
+		 * @return The index. Throws std::runtime_error if the file doesn't exist.
+		 */
+		CsvIndex index_CSV(const std::string &path)
+		{
+			return CsvIndex::open(path);
+		}
+
+		/**
+		 * @brief Function to load the submatrix made of rows [row_begin, row_end) and columns [col_begin, col_end) of a .csv file. The rows are found
+		 * with the row offset index (MATOPS::CsvIndex), so only the bytes of the requested rows are read and only the requested cells are converted.
+		 * @param path = "path to A.csv"
+		 * @return The submatrix as a 2D vector. Throws std::runtime_error if the file doesn't exist and std::invalid_argument if the range is outside
+		 * the Matrix.
+		 */
+		std::vector<std::vector<Data1>> load_submatrix(const std::string &path, size_t row_begin, size_t row_end, size_t col_begin, size_t col_end)
+		{
+			CsvIndex index=CsvIndex::open(path);
+			if(row_begin>row_end || row_end>index.rows() || col_begin>col_end || col_end>index.cols())
+			{
+				throw std::invalid_argument("Submatrix range is outside the Matrix in '"+path+"'");
+			}
+			std::ifstream indata(path,std::ios::binary);
+			if(indata.fail())
+			{
+				throw std::runtime_error("File path: '"+path+"' doesn't exist");
+			}
+			return read_rows(indata,index,row_begin,row_end,col_begin,col_end);
+		}
+
+		/**
+		 * @brief Write the row offset index sidecar ("<path>.idx", see MATOPS::CsvIndex) of every file parsed by this object as a by-product of parsing
+		 * it, so later partial loads (MATOPS::BigMatrix<Data1>::load_submatrix) and previews don't need an extra pass. Off by default.
+		 * @param enable = True to write the sidecars
+		 */
+		void enable_csv_index(bool enable=true)
+		{
+			CSV_INDEX=enable;
+		}
+
+		/**
+		 * @brief Function to load a Matrix from a .csv file into a MATOPS::DynMatrix, Eg. to work on mid sized matrices in memory.
+		 * @param path = "path to A.csv"
+		 * @return The loaded Matrix. Throws std::runtime_error if the file doesn't exist.
+		 */
+		DynMatrix<Data1> load(const std::string &path)
+		{
+			return DynMatrix<Data1>(read_CSV(path));
+		}
+
+		/**
+		 * @brief Function to store a MATOPS::DynMatrix in a .csv file.
+		 * @param M = Matrix to store
+		 * @param path = "path to destination csv file"
+		 * @return Returns false if the destination file could not be opened or written.
+		 */
+		template<size_t INLINE_SIZE>
+		bool store(const DynMatrix<Data1,INLINE_SIZE> &M, const std::string &path)
+		{
+			std::ofstream file;
+			file.open(path);
+			if(file.fail())
+			{
+				return false;
+			}
+			for(size_t i=0;i<M.rows();i++)
+			{
+				for(size_t j=0;j<M.cols();j++)
+				{
+					file<<M.ElementAt(i,j)<<((j+1<M.cols())? ",":"\n");
+				}
+			}
+			file.close();
+			return !file.fail();
+		}
+		
+		/** 
+		 * @brief This Function sets the LEAF_SIZE i.e. the array size at which we shift from Strassan's Algo to normal O(n^3) solution, this prevents the 
+		 * StrassenMultiply recursion function from down to a leaf size/Matrix size of 1. Once we reach a square matrix array of size LEAF_SIZE x LEAF_SIZE 
+		 * or lesser, we perform the multiplication using the naive O(n^3) time complexity solution. 
+		 * 
+		 * 		A very high value of LEAF_SIZE leads to lesser recursion calls but ends up giving more weightage to the O(n^3) solution, thus suffer high 
+		 * 		execution time. 
+		 * 
+		 * 		On the other hand a very low LEAF_SIZE value leads to higher number of resursion calls and gives lesser weightage to the O(n^3) solution, 
+		 * 		which again leads to high execution time. 
+		 * 
+		 * Hence an optimal LEAF_SIZE value has to be found that gives the minimum execution time by finding a trade off between the O(n^3) solution and recurssion 
+		 * calls. This indirectly implies that the value of LEAF_SIZE vary from one machine to another, thus we need to experimentally find out this value for each 
+		 * machine and configure the matrix.h library accordingly. This experimentation is done by the configure_lib.cpp, which raises the SET_LEAF_SIZE flag 
+		 * (thus activating the set_LEAF_SIZE() function) during execution, as a result of which the "matrix.h" library is called (in its configuration mode) by 
+		 * configure_lib.cpp. This allows configure_lib.cpp to manipulate the LEAF_SIZE (private variable) of the matrix.h file. Hence configure.cpp can test the 
+		 * hardware for different values of LEAF_SIZE and pick its optimal (i.e. the value that gives the lowest execution time) value and finally store the optimal 
+		 * value in the configure.txt file. 
+		 * 
+		 * On a BigMatrix<Data1,STATIC_LEAF_SIZE> with STATIC_LEAF_SIZE > 0 the LEAF_SIZE can't change: any other value throws std::invalid_argument.
+		 */
+		void set_LEAF_SIZE(int leaf_size)
+		{
+			if(STATIC_LEAF_SIZE>0 && leaf_size!=STATIC_LEAF_SIZE) // The leaf kernel is instantiated for STATIC_LEAF_SIZE only.
+			{
+				throw std::invalid_argument("LEAF_SIZE is fixed to "+std::to_string(STATIC_LEAF_SIZE)+" at compile time");
+			}
+			LEAF_SIZE=leaf_size;
+			LEAF_SIZE_PINNED=true;
+		}
+		#ifndef SET_LEAF_SIZE
+		/**
+		 * @brief When matrix.h is normally called i.e. without any SET_LEAF_SIZE flag, set_configerd_Leaf_size() function gets activated (set_LEAFT_SIZE() function
+		 * gets deactivated). The set_configerd_Leaf_size() function searches for the configure.txt file (generated earlier by configure_lib.cpp during the configuration
+		 * process) and sets the optimal value of LEAF_SIZE. This function is called by the  MATOPS::BigMatrix<Data1>::matmul before starting the multiplication process.
+		 * It does nothing when the LEAF_SIZE is fixed by STATIC_LEAF_SIZE or was set explicitly with set_LEAF_SIZE(), which is available in both modes.
+		 * 
+		 */
+		void set_configerd_Leaf_size()
+		{
+			if(STATIC_LEAF_SIZE>0 || LEAF_SIZE_PINNED) // Fixed at compile time or by set_LEAF_SIZE(), no configure.txt needed.
+			{
+				return;
+			}
+			std::ifstream indata;
+			indata.open("configure.txt");
+			std::string str="";
+			getline(indata,str);
+			indata.close();
+			LEAF_SIZE=std::stoi(str);
+		}
+		#endif
+
+		/**
+		 * @brief Set the density (fraction of non zero values) at or below which matmul multiplies A with the MATOPS::SparseMatrix kernels instead
+		 * of Strassen's Algorithm. The default is 0.05, i.e. matrices with 95% or more zeros. 0 disables the sparse path.
+		 * @param threshold = Density threshold between 0 and 1
+		 */
+		void set_sparse_threshold(double threshold)
+		{
+			SPARSE_THRESHOLD=threshold;
+		}
+
+		/**
+		 * @brief Set the changed fraction (of the rows of A, the columns of B, or the rank of a low rank update relative to the smallest dimension)
+		 * above which the incremental updates (MATOPS::BigMatrix<Data1>::update_rows, update_cols, update_low_rank and matmul_update) recompute the
+		 * whole product instead. The default is 0.25.
+		 * @param threshold = Fraction between 0 and 1
+		 */
+		void set_incremental_threshold(double threshold)
+		{
+			INCREMENTAL_THRESHOLD=threshold;
+		}
+
+		/**
+		 * @brief Switch matmul to the quantized GEMM path. The operands are quantized to int8 or int16 (A per row, B per column), multiplied with
+		 * wide integer accumulation and the dequantized result is stored as float values. Quantization::NONE (the default) restores the exact path.
+		 * @param mode = Quantization::NONE, Quantization::INT8 or Quantization::INT16
+		 */
+		void set_quantization(Quantization mode)
+		{
+			QUANTIZATION=mode;
+		}
+
+		/**
+		 * @brief Turn on the on-disk result cache (MATOPS::ResultCache) for matmul and Transpose. When an operation is called again on input files
+		 * whose contents didn't change (and with the same datatype and algorithm parameters), its previous result is copied to the destination instead
+		 * of being computed again.
+		 * @param dir = Directory holding the cached results
+		 * @param max_bytes = Upper bound on the size of the cache, the least recently used results are deleted beyond it.
+		 */
+		void enable_cache(std::string dir, uintmax_t max_bytes=(uintmax_t)1<<30)
+		{
+			CACHE=std::make_shared<ResultCache>(dir,max_bytes);
+		}
+
+		/**
+		 * @brief Turn the result cache off again. Cached results stay on disk.
+		 */
+		void disable_cache()
+		{
+			CACHE.reset();
+		}
+
+		/**
+		 * @return Returns the result cache (for its hit/miss counters), NULL if it isn't enabled.
+		 */
+		ResultCache* result_cache()
+		{
+			return CACHE.get();
+		}
+
+		// Matrix Multiplication from CSV files
+		/**
+		 * @brief This is the BigMatrix multiplication Function that multiplies two matrices A and B stored in A.csv and B.csv respectively and store the result in C.csv file.
+		 * Before beginning the multiplication process it calls the MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function to parses the configure.txt (generated by 
+		 * configure_lib.cpp during the configuration process) and sets the optimal LEAF_SIZE value.
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path to a store file (no need to predefine C.csv file in the directory, it gets generated automatically.)
+		 * @param print = True, To see all the Matrices i.e. A,B and C in the output terminal/stdio.
+		 * 
+		 * Overall Working: When matmul is called, it first sets the the optimal LEAF_SIZE value. It then loads the two csv files from "path to A.csv" and "path to B.csv"
+		 * directories into two 2D vectors namely MAT_1 and MAT_2 of type Data1 using MATOPS::BigMatrix<Data1>::load_CSV function. The dimensions of both the matrices are determined 
+		 * from MAT_1 and MAT_2 say m_1,n_1 ad m_2,n_2 respectively. If the inner dimensions of both MAT_1 and MAT_2 don't match an error is thrown and the program is exited. If the 
+		 * inner dimensions match then we proceed for Multiplication. Before calling the MATOPS::BigMatrix<Data1>::StrassenMultiply fuction, we pad the matrices with zeros to make both
+		 * MAT_1 and MAT_2 square matrices of equal dimension, dim_n. Where dim_n is a power of 2 i.e. greater than or equal to max(m_1,n_1,n_2) or max(m_1,m_2,n_2) (since n_1=m_2). We 
+		 * callocate (by calling MATOPS::BigMatrix<Data1>::Init_matrix(dim_n) two chunk of memory of size dim_n x dim_n pointed by pointers A and B. Finally  we build the Zero padded square
+		 * Matrices by copying the contents from from MAT_1 and MAT_2 into the memory (pointed by A and B) respectively. These Memory addresses and dim_n are then passed on to the 
+		 * MATOPS::BigMatrix<Data1>::StrassenMultiply function to evaluate the product of A and B. The MATOPS::BigMatrix<Data1>::StrassenMultiply() func returns a pointer pointing 
+		 * to a location in the memory where the answer is stored. This memory address is then passed to the MATOPS::BigMatrix<Data1>::store_csv() along with the resultant matrix 
+		 * dimension (i.e. m_1 x n_2) and the storage destination path to store the final result in a csv file.
+		 * 
+		 * Finally all the allocated memories are freed up using Free_matrix.
+		 *
+		 * If A has a density at or below the sparse threshold (see MATOPS::BigMatrix<Data1>::set_sparse_threshold) the padding and Strassen's Algorithm are
+		 * skipped, A is parsed straight into a MATOPS::SparseMatrix (see MATOPS::BigMatrix<Data1>::read_operand, the dense form is never built) and
+		 * multiplied with the multithreaded SpMM kernel (SpGEMM if B is sparse as well).
+		 * When a quantization mode is set (see MATOPS::BigMatrix<Data1>::set_quantization) the product is computed by MATOPS::quantized_multiply instead.
+		 * When B has at most GEMV_MAX_COLS columns (and print is false) A is streamed through MATOPS::BigMatrix<Data1>::matmul_gemv instead of being loaded.
+		 * 	
+		 */
+		void matmul(std::string file_1, std::string file_2, std::string path, bool print=false)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size(); // The LEAF_SIZE is part of the cache key.
+			#endif
+			if(print==true)
+			{
+				matmul_uncached(file_1,file_2,path,print);
+				return;
+			}
+			cached("matmul",{file_1,file_2},path,[&]{ matmul_uncached(file_1,file_2,path); });
+		}
+
+		/**
+		 * @brief The body of MATOPS::BigMatrix<Data1>::matmul without the result cache lookup.
+		 */
+		void matmul_uncached(std::string file_1, std::string file_2, std::string path, bool print=false)
+
+				{   
+					
+					#ifndef SET_LEAF_SIZE 
+						set_configerd_Leaf_size(); // Set the optimal LEAF_SIZE by parsing the configuration file genrated by configure_lib.cpp.
+					#endif
+					// std::cout<<"Current LEAF_SIZE value: "<<LEAF_SIZE<<'\n'; // Just a check to see what LEAF_SIZE value is being used
+					
+					// A thin B (a vector or a few columns): stream A instead of loading it and padding everything to a power of 2 square.
+					if(print==false && QUANTIZATION==Quantization::NONE)
+					{
+						size_t m_2=0, n_2=0;
+						try{
+							csv_shape(file_2,m_2,n_2); // Same notion of rows and blank lines as the parsers
+						}catch (const std::runtime_error &err)
+						{
+							std::cerr<<err.what()<<'\n';
+							exit(0);
+						}
+						if(m_2>0 && n_2<=GEMV_MAX_COLS)
+						{
+							matmul_gemv(file_1,file_2,path);
+							return;
+						}
+					}
+
+					// Parse the CSV files and get the Matrices to be multiplied. Mostly zero operands are parsed straight into CSR form.
+
+					std::vector<std::vector<Data1>> MAT_1, MAT_2;
+					SparseMatrix<Data1> S_1, S_2;
+					bool sparse_1=false, sparse_2=false;
+					try{
+						sparse_1=read_operand(file_1,S_1,MAT_1,QUANTIZATION==Quantization::NONE);
+						sparse_2=read_operand(file_2,S_2,MAT_2,QUANTIZATION==Quantization::NONE);
+						if((sparse_1? S_1.rows() : MAT_1.size())==0 || (sparse_2? S_2.rows() : MAT_2.size())==0)
+						{
+							throw std::runtime_error("Empty Matrix file");
+						}
+					}catch (const std::runtime_error &err)
+					{
+						std::cerr<<err.what()<<'\n';
+						exit(0);
+					}
+
+					// Get the dimensions of both the Matrices.
+					size_t m_1= sparse_1? S_1.rows() : MAT_1.size(), n_1= sparse_1? S_1.cols() : MAT_1[0].size();  // Matrix 1 M,N
+					size_t m_2= sparse_2? S_2.rows() : MAT_2.size(), n_2= sparse_2? S_2.cols() : MAT_2[0].size(); // Matrix 2 M,N
+
+					try{
+						if(n_1 != m_2) // Check if inner dimensions of the Matrices Match. If not then Throw error.
+						{
+							throw "Matrix Inner Dimensions don't match !!! \n";
+						}
+					  }catch (const char* msg)
+						{
+							std::cerr<<msg<<'\n';
+							exit(0);
+						}
+
+						// Quantized path: int8/int16 operands, wide accumulation and float output.
+						if(QUANTIZATION!=Quantization::NONE)
+						{
+							ThreadPool pool;
+							std::vector<std::vector<float>> C_quantized=quantized_multiply(MAT_1,MAT_2,QUANTIZATION,pool);
+							if(print==true)
+							{
+								std::cout<<"A: \n";
+								print_Mat(MAT_1);
+								std::cout<<"\nB: \n";
+								print_Mat(MAT_2);
+								std::cout<<"\nANSWER: \n";
+								for(const std::vector<float> &row: C_quantized)
+								{
+									for(float x: row)
+									{
+										std::cout<<x<<" ";
+									}
+									std::cout<<'\n';
+								}
+							}
+							store_csv<float>(C_quantized,path);
+							return;
+						}
+
+						// Mostly zero A: skip the padding and Strassen's Algorithm and use the sparse kernels instead.
+						if(sparse_1)
+						{
+							ThreadPool pool;
+							std::vector<std::vector<Data1>> C_sparse= sparse_2? S_1.multiply(S_2,pool).to_dense() : S_1.multiply(MAT_2,pool);
+							if(print==true)
+							{
+								std::cout<<"A: \n";
+								print_Mat(S_1.to_dense());
+								std::cout<<"\nB: \n";
+								print_Mat(sparse_2? S_2.to_dense() : MAT_2);
+								std::cout<<"\nANSWER: \n";
+								print_Mat(C_sparse);
+							}
+							store_csv<Data1>(C_sparse,path);
+							return;
+						}
+						if(sparse_2) // Dense A times sparse B goes through Strassen's Algorithm.
+						{
+							MAT_2=S_2.to_dense();
+							S_2=SparseMatrix<Data1>();
+						}
+
+						size_t max_n= std::max(std::max(m_1,n_1),n_2); // Find the max of all the Matrix dimensions, to find the next highest power of 2.
+						size_t dim_n=1;
+
+						// Find the next highest power of 2 using left shift operator (dim_n = Next highest power of 2).
+						// This will be used to pad zeros to both matrices A and B, and ultimately given as input to StrassenMultiply() function.
+						while(dim_n<max_n)
+						{
+							dim_n=dim_n<<1;
+						}
+
+						// Initialize 3 pointers to point at Matrices A and B, and to store the Result of AxB into C.
+						Data1 ** A;
+						Data1 ** B;
+						Data1 ** C;
+
+						A=Init_matrix(dim_n); // Allocate the memory for Matrix A of size dim_n
+						B=Init_matrix(dim_n); // Allocate the memory for Matrix B of size dim_n
+
+						// Build the Zero padded square Matrices A and B by copying contents from from MAT_1 and MAT_2 into A and B respectively.
+							for(size_t k=0;k<m_1;k++)
+							{
+								for(size_t l=0;l<n_1;l++)
+								{
+									A[k][l]= MAT_1[k][l];
+								}
+							}
+
+							for(size_t k=0;k<m_2;k++)
+							{
+								for(size_t l=0;l<n_2;l++)
+								{
+									B[k][l]= MAT_2[k][l];
+
+								}
+
+							}
+
+						//Call Strassen's Algorithm function to get A x B and store in C.
+							C=StrassenMultiply(A, B, dim_n);
+
+						if(print==true) // if print is true then print A, B and the result A.
+							{
+									std::cout<<"A: \n";
+									print_Mat(A, m_1, n_1); //Call the print_Mat function to print the Matrix
+
+									std::cout<<"\nB: \n";
+									print_Mat(B, m_2, n_2); //Call the print_Mat function to print the Matrix
+
+									std::cout<<"\nANSWER: \n"; //Call the print_Mat function to print the Matrix
+									print_Mat(C, m_1, n_2);
+
+							}
+
+						// Store the Result C into a CSV file, whose location is given by "path"
+						store_csv<Data1>(C, m_1,n_2,path);
+
+						// Free The memory before quitting
+						Free_matrix(A);
+						Free_matrix(B);
+						Free_matrix(C);
+
+
+				} // matmul function ends here
+
+		/**
+		 * @brief Function to find the dimensions of a Matrix stored in a CSV file without parsing its values. The rows are counted as the number of non
+		 * blank lines (empty or a lone "\r") and the cols as the number of cells in the first of them.
+		 * @param path = "path to A.csv"
+		 * @param rows = Returns the No. of Rows
+		 * @param cols = Returns the No. of Columns
+		 *
+		 * Throws std::runtime_error if the file doesn't exist.
+		 */
+		void csv_shape(const std::string &path, size_t &rows, size_t &cols)
+		{
+			std::ifstream indata;
+			indata.open(path);
+			if(indata.fail())
+			{
+				throw std::runtime_error("File path: '"+path+"' doesn't exist");
+			}
+			rows=0;
+			cols=0;
+			std::string line="";
+			while(getline(indata,line))
+			{
+				if(line.empty() || line=="\r")
+				{
+					continue;
+				}
+				if(rows==0)
+				{
+					cols=std::count(line.begin(),line.end(),',')+1;
+				}
+				rows++;
+			}
+			indata.close();
+		}
+
+		// Batched Matrix Multiplication
+		/**
+		 * @brief Run many independent multiplications (file_1 x file_2 -> path) on one shared MATOPS::ThreadPool.
+		 * @param jobs = List of jobs to run
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @param memory_budget = Upper bound (in bytes) on the estimated working set of all jobs running at the same time, 0 means unlimited.
+		 * @return One MATOPS::JobResult per job (same order as jobs) with the status and the time spent in each phase.
+		 *
+		 * Overall Working: The LEAF_SIZE is set once for the whole batch. Every job first reads the shapes of its operands (MATOPS::BigMatrix<Data1>::csv_shape),
+		 * so dimension mismatches are reported before anything is parsed, and its working set (parsed operands, padded operands and the Strassen temporaries,
+		 * roughly 14 x dim_n^2 elements) is reserved from a MATOPS::MemoryBudget. Operands are shared between jobs: a file used by several jobs is parsed once
+		 * by the first job that needs it and dropped after its last user is done. Operands are parsed like in matmul (read_operand), so a mostly zero operand
+		 * is built straight in CSR form and multiplied with the MATOPS::SparseMatrix kernels without a dense copy. Since the jobs run on several workers, the parsing and storing of some jobs
+		 * overlaps with the multiplication of others. Errors never exit the program, they are reported in the result of the failing job.
+		 */
+		std::vector<JobResult> matmul_batch(const std::vector<MatmulJob> &jobs, size_t n_threads=0, size_t memory_budget=0)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size(); // Read configure.txt once for the whole batch.
+			#endif
+
+			// An operand in the form it is multiplied in (see read_operand): CSR if it is mostly zero, dense otherwise.
+			struct Operand
+			{
+				SparseMatrix<Data1> S;
+				std::vector<std::vector<Data1>> MAT;
+				bool sparse=false;
+			};
+			typedef std::shared_future<std::shared_ptr<const Operand>> SharedOperand;
+
+			std::vector<JobResult> results(jobs.size());
+			std::map<std::string,int> users; // No. of jobs that still need an operand
+			std::map<std::string,SharedOperand> operands;
+			std::mutex operands_mutex;
+			MemoryBudget budget(memory_budget);
+
+			for(const MatmulJob &job: jobs)
+			{
+				users[job.file_1]++;
+				users[job.file_2]++;
+			}
+
+			// Returns the (possibly shared) operand, the first caller parses it and every other caller waits for it.
+			auto acquire_operand=[&](const std::string &file) -> SharedOperand
+			{
+				std::lock_guard<std::mutex> lock(operands_mutex);
+				typename std::map<std::string,SharedOperand>::iterator it=operands.find(file);
+				if(it==operands.end())
+				{
+					SharedOperand loader=std::async(std::launch::deferred,[this,file]{
+						std::shared_ptr<Operand> op(new Operand());
+						op->sparse=read_operand(file,op->S,op->MAT);
+						return std::shared_ptr<const Operand>(op);
+					}).share();
+					it=operands.insert(std::make_pair(file,loader)).first;
+				}
+				return it->second;
+			};
+
+			// Drop the operand once the last job using it is done.
+			auto release_operand=[&](const std::string &file)
+			{
+				std::lock_guard<std::mutex> lock(operands_mutex);
+				if(--users[file]==0)
+				{
+					operands.erase(file);
+				}
+			};
+
+			{
+				ThreadPool pool(n_threads);
+				std::vector<std::future<void>> pending;
+
+				for(size_t j=0;j<jobs.size();j++)
+				{
+					pending.push_back(pool.submit([&,j]{
+						const MatmulJob &job=jobs[j];
+						JobResult &result=results[j];
+						std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+						std::chrono::steady_clock::time_point mark=start;
+						auto lap=[&mark]{
+							std::chrono::steady_clock::time_point now=std::chrono::steady_clock::now();
+							std::chrono::duration<double> elapsed=now-mark;
+							mark=now;
+							return elapsed.count();
+						};
+
+						size_t reserved=0;
+						bool operands_released=false;
+						try{
+							size_t m_1, n_1, m_2, n_2;
+							csv_shape(job.file_1,m_1,n_1);
+							csv_shape(job.file_2,m_2,n_2);
+							if(m_1==0 || m_2==0)
+							{
+								throw std::runtime_error("Empty Matrix file");
+							}
+							if(n_1!=m_2)
+							{
+								result.status=JobStatus::DIMENSION_MISMATCH;
+								result.message="Matrix Inner Dimensions don't match !!!";
+							}
+							else
+							{
+								size_t dim_n=1;
+								while(dim_n<std::max(std::max(m_1,n_1),n_2))
+								{
+									dim_n=dim_n<<1;
+								}
+								reserved=budget.acquire((14*dim_n*dim_n+m_1*n_1+m_2*n_2)*sizeof(Data1));
+								result.wait_time=lap();
+
+								SharedOperand op_1=acquire_operand(job.file_1);
+								SharedOperand op_2=acquire_operand(job.file_2);
+								std::shared_ptr<const Operand> MAT_1=op_1.get();
+								std::shared_ptr<const Operand> MAT_2=op_2.get();
+								result.load_time=lap();
+
+								size_t dim=0;
+								Data1** C=NULL;
+								std::vector<std::vector<Data1>> C_sparse;
+								if(MAT_1->sparse)
+								{
+									C_sparse= MAT_2->sparse? MAT_1->S.multiply(MAT_2->S,pool).to_dense() : MAT_1->S.multiply(MAT_2->MAT,pool);
+								}
+								else if(MAT_2->sparse) // Dense A times sparse B goes through Strassen's Algorithm, as in matmul.
+								{
+									C=multiply_padded(MAT_1->MAT,MAT_2->S.to_dense(),dim);
+								}
+								else
+								{
+									C=multiply_padded(MAT_1->MAT,MAT_2->MAT,dim);
+								}
+								MAT_1.reset();
+								MAT_2.reset();
+								release_operand(job.file_1);
+								release_operand(job.file_2);
+								operands_released=true;
+								result.compute_time=lap();
+
+								bool stored;
+								if(C!=NULL)
+								{
+									stored=store_csv<Data1>(C,m_1,n_2,job.path);
+									Free_matrix(C);
+								}
+								else
+								{
+									stored=store_csv<Data1>(C_sparse,job.path);
+								}
+								result.store_time=lap();
+								if(!stored)
+								{
+									throw std::runtime_error("Can't write to file path: '"+job.path+"'");
+								}
+							}
+						}catch (const std::exception &err)
+						{
+							result.status=JobStatus::FILE_ERROR;
+							result.message=err.what();
+						}
+						if(!operands_released)
+						{
+							release_operand(job.file_1);
+							release_operand(job.file_2);
+						}
+						budget.release(reserved);
+						std::chrono::duration<double> total=std::chrono::steady_clock::now()-start;
+						result.total_time=total.count();
+					}));
+				}
+
+				for(std::future<void> &f: pending)
+				{
+					f.get();
+				}
+			}
+			return results;
+		}
+
+		// Matrix Chain Multiplication
+		/**
+		 * @brief Multiply a chain of in-memory Matrices MATS[0] x MATS[1] x ... in the cheapest order.
+		 * @param MATS = Matrices of the chain, MATS[i] must have as many columns as MATS[i+1] has rows.
+		 * @return The product of the chain as a 2D vector.
+		 *
+		 * Throws std::invalid_argument if the chain is empty or the inner dimensions don't match.
+		 */
+		std::vector<std::vector<Data1>> multiply_chain(const std::vector<std::vector<std::vector<Data1>>> &MATS)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			std::vector<size_t> dims;
+			for(size_t i=0;i<MATS.size();i++)
+			{
+				if(MATS[i].empty() || (i>0 && MATS[i].size()!=dims.back()))
+				{
+					throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+				}
+				if(i==0)
+				{
+					dims.push_back(MATS[i].size());
+				}
+				dims.push_back(MATS[i][0].size());
+			}
+			if(MATS.empty())
+			{
+				throw std::invalid_argument("Empty Matrix chain");
+			}
+			PadBuffers buffers;
+			std::vector<std::vector<Data1>> C=evaluate_chain(chain_order(dims),0,MATS.size()-1,[&MATS](int i){ return MATS[i]; },buffers);
+			Free_pad_buffers(buffers);
+			return C;
+		}
+
+		/**
+		 * @brief Multiply a chain of Matrices stored in csv files (files[0] x files[1] x ...) and store only the final result.
+		 * @param files = "path to A1.csv", "path to A2.csv", ...
+		 * @param path = path to store the product
+		 * @param print = True, To see the result in the output terminal/stdio.
+		 *
+		 * Overall Working: The shapes of all the Matrices are read first (MATOPS::BigMatrix<Data1>::csv_shape) without parsing any value. The optimal
+		 * parenthesization is found by dynamic programming where every product costs the cheaper of the classical O(n^3) product and Strassen's Algorithm
+		 * on the zero padded operands (with the configured LEAF_SIZE). The chain is then evaluated in memory: every file is parsed only when its product is
+		 * reached, intermediates never touch the disk and the padded Strassen operands are kept in one pair of buffers reused by all steps.
+		 */
+		void matmul_chain(const std::vector<std::string> &files, std::string path, bool print=false)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			std::vector<size_t> dims;
+			try{
+				if(files.empty())
+				{
+					throw std::runtime_error("Empty Matrix chain");
+				}
+				for(size_t i=0;i<files.size();i++)
+				{
+					size_t rows, cols;
+					csv_shape(files[i],rows,cols);
+					if(rows==0 || (i>0 && rows!=dims.back()))
+					{
+						throw std::runtime_error("Matrix Inner Dimensions don't match !!! ('"+files[i]+"')");
+					}
+					if(i==0)
+					{
+						dims.push_back(rows);
+					}
+					dims.push_back(cols);
+				}
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+
+			PadBuffers buffers;
+			std::vector<std::vector<Data1>> C=evaluate_chain(chain_order(dims),0,files.size()-1,[this,&files](int i){ return load_CSV(files[i]); },buffers);
+			Free_pad_buffers(buffers);
+
+			if(print==true)
+			{
+				std::cout<<"ANSWER: \n";
+				print_Mat(C);
+			}
+			store_csv<Data1>(C,path);
+		}
+
+		// Streaming Matrix-Vector Multiplication
+		/**
+		 * @brief Multiply A (in file_1) with a thin B (in file_2, a single or a few columns) without loading A into memory.
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path to store the result
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 *
+		 * Overall Working: B is loaded and stored transposed so that every column of B is contiguous. A is then read once, in stripes of GEMV_STRIPE rows.
+		 * Every stripe is parsed and multiplied (one MATOPS::dot_product per row and column of B) as a task on the pool while the next stripes are read,
+		 * and the finished stripes are written to the output in order. At most 2 stripes per worker are in flight, so the extra memory is B plus a few
+		 * stripes, independent of the size of A. MATOPS::BigMatrix<Data1>::matmul switches to this function when B has at most GEMV_MAX_COLS columns.
+		 */
+		void matmul_gemv(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			std::vector<std::vector<Data1>> MAT_2=load_CSV(file_2);
+			try{
+				if(MAT_2.empty())
+				{
+					throw std::runtime_error("Empty Matrix file");
+				}
+				for(const std::vector<Data1> &row: MAT_2)
+				{
+					if(row.size()!=MAT_2[0].size())
+					{
+						throw std::runtime_error("Matrix Dimensions don't match !!!");
+					}
+				}
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			size_t m_2=MAT_2.size(), n_2=MAT_2[0].size();
+			std::vector<std::vector<Data1>> B_T(n_2,std::vector<Data1>(m_2));
+			for(size_t i=0;i<m_2;i++)
+			{
+				for(size_t j=0;j<n_2;j++)
+				{
+					B_T[j][i]=MAT_2[i][j];
+				}
+			}
+			MAT_2.clear();
+
+			std::ifstream indata;
+			indata.open(file_1);
+			if(indata.fail())
+			{
+				std::cerr<<"File path: '"<<file_1<<"' doesn't exist\n";
+				exit(0);
+			}
+			std::ofstream file;
+			file.open(path);
+			if(file.fail())
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+
+			// Parse and multiply one stripe of rows of A, returns the csv text of the matching rows of the result.
+			auto run_stripe=[&B_T,m_2,n_2](std::vector<std::string> lines){
+				std::ostringstream out;
+				std::vector<Data1> row;
+				row.reserve(m_2);
+				for(const std::string &line: lines)
+				{
+					row.clear();
+					std::stringstream lineStream(line);
+					std::string cell;
+					while(std::getline(lineStream,cell,','))
+					{
+						row.push_back(convert_to<Data1>(cell));
+					}
+					if(row.size()!=m_2)
+					{
+						throw std::runtime_error("Matrix Inner Dimensions don't match !!!");
+					}
+					for(size_t j=0;j<n_2;j++)
+					{
+						out<<dot_product(row.data(),B_T[j].data(),m_2)<<((j+1<n_2)? ",":"\n");
+					}
+				}
+				return out.str();
+			};
+
+			try{
+				bool rows_read=false;
+				{
+					ThreadPool pool(n_threads);
+					stream_stripes<std::vector<std::string>>(pool,[&indata,&rows_read](std::vector<std::string> &lines, bool &more){
+						more=read_stripe(indata,lines,GEMV_STRIPE);
+						rows_read= rows_read || !lines.empty();
+						return !lines.empty();
+					},run_stripe,[&file](const std::string &text){
+						file<<text;
+					});
+				}
+				if(!rows_read)
+				{
+					file.close();
+					std::remove(path.c_str());
+					throw std::runtime_error("Empty Matrix file");
+				}
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			indata.close();
+			file.close();
+			if(file.fail())
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+		}
+
+		// Element-wise operations and reductions
+		/**
+		 * @brief Fused element-wise expression alpha * A + beta * (B o C) on in-memory Matrices, where o is the element-wise (Hadamard) product.
+		 * The whole expression is evaluated in one multithreaded pass without temporaries.
+		 * @param alpha = Scale of A
+		 * @param MAT_1 = Matrix A
+		 * @param beta = Scale of B o C
+		 * @param MAT_2 = Matrix B
+		 * @param MAT_3 = Matrix C
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @return The result. Throws std::invalid_argument if the Matrices don't have the same shape.
+		 */
+		std::vector<std::vector<Data1>> elementwise(Data1 alpha, const std::vector<std::vector<Data1>> &MAT_1, Data1 beta,
+				const std::vector<std::vector<Data1>> &MAT_2, const std::vector<std::vector<Data1>> &MAT_3, size_t n_threads=0)
+		{
+			Expression e;
+			e.alpha=alpha;
+			e.beta=beta;
+			return evaluate(e,&MAT_1,&MAT_2,&MAT_3,n_threads);
+		}
+
+		/**
+		 * @brief Fused element-wise expression alpha * A + beta * (B o C) on Matrices stored in csv files, written to path in one streaming
+		 * multithreaded pass. The files are read in lockstep in stripes of rows, so only a few stripes of every file are held in memory.
+		 * @param alpha = Scale of A
+		 * @param file_1 = "path to A.csv"
+		 * @param beta = Scale of B o C
+		 * @param file_2 = "path to B.csv"
+		 * @param file_3 = "path to C.csv", "" computes alpha * A + beta * B. Giving C without B is an error.
+		 * @param path = path to store the result
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void elementwise(Data1 alpha, std::string file_1, Data1 beta, std::string file_2, std::string file_3, std::string path, size_t n_threads=0)
+		{
+			Expression e;
+			e.alpha=alpha;
+			e.beta=beta;
+			stream_evaluate(e,file_1,file_2,file_3,path,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise sum A + B of in-memory Matrices. Throws std::invalid_argument if the shapes don't match.
+		 */
+		std::vector<std::vector<Data1>> add(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, size_t n_threads=0)
+		{
+			Expression e;
+			e.beta=Data1(1);
+			return evaluate(e,&MAT_1,&MAT_2,NULL,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise sum A + B of Matrices stored in csv files, streamed to path.
+		 */
+		void add(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			elementwise(Data1(1),file_1,Data1(1),file_2,"",path,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise difference A - B of in-memory Matrices. Throws std::invalid_argument if the shapes don't match.
+		 */
+		std::vector<std::vector<Data1>> sub(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, size_t n_threads=0)
+		{
+			Expression e;
+			e.beta=Data1(-1);
+			return evaluate(e,&MAT_1,&MAT_2,NULL,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise difference A - B of Matrices stored in csv files, streamed to path.
+		 */
+		void sub(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			elementwise(Data1(1),file_1,Data1(-1),file_2,"",path,n_threads);
+		}
+
+		/**
+		 * @brief Scaled copy alpha * A of an in-memory Matrix.
+		 */
+		std::vector<std::vector<Data1>> scale(const std::vector<std::vector<Data1>> &MAT, Data1 alpha, size_t n_threads=0)
+		{
+			Expression e;
+			e.alpha=alpha;
+			return evaluate(e,&MAT,NULL,NULL,n_threads);
+		}
+
+		/**
+		 * @brief Scaled copy alpha * A of a Matrix stored in a csv file, streamed to path.
+		 */
+		void scale(std::string file, Data1 alpha, std::string path, size_t n_threads=0)
+		{
+			Expression e;
+			e.alpha=alpha;
+			stream_evaluate(e,file,"","",path,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise (Hadamard) product A o B of in-memory Matrices. Throws std::invalid_argument if the shapes don't match.
+		 */
+		std::vector<std::vector<Data1>> hadamard(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, size_t n_threads=0)
+		{
+			Expression e;
+			e.beta=Data1(1);
+			return evaluate(e,NULL,&MAT_1,&MAT_2,n_threads);
+		}
+
+		/**
+		 * @brief Element-wise (Hadamard) product A o B of Matrices stored in csv files, streamed to path.
+		 */
+		void hadamard(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			Expression e;
+			e.beta=Data1(1);
+			stream_evaluate(e,"",file_1,file_2,path,n_threads);
+		}
+
+		/**
+		 * @brief Copy of an in-memory Matrix with every element clamped to [lo, hi].
+		 */
+		std::vector<std::vector<Data1>> clamp(const std::vector<std::vector<Data1>> &MAT, Data1 lo, Data1 hi, size_t n_threads=0)
+		{
+			Expression e;
+			e.clamp=true;
+			e.lo=lo;
+			e.hi=hi;
+			return evaluate(e,&MAT,NULL,NULL,n_threads);
+		}
+
+		/**
+		 * @brief Copy of a Matrix stored in a csv file with every element clamped to [lo, hi], streamed to path.
+		 */
+		void clamp(std::string file, Data1 lo, Data1 hi, std::string path, size_t n_threads=0)
+		{
+			Expression e;
+			e.clamp=true;
+			e.lo=lo;
+			e.hi=hi;
+			stream_evaluate(e,file,"","",path,n_threads);
+		}
+
+		/**
+		 * @brief Sum of all the elements of an in-memory Matrix, accumulated in double.
+		 */
+		double sum(const std::vector<std::vector<Data1>> &MAT)
+		{
+			double total=0;
+			for(const std::vector<Data1> &row: MAT)
+			{
+				total+=row_sum(row.data(),row.size());
+			}
+			return total;
+		}
+
+		/**
+		 * @brief Sum of all the elements of a Matrix stored in a csv file, accumulated in double in one streaming multithreaded pass.
+		 */
+		double sum(std::string file, size_t n_threads=0)
+		{
+			return stream_reduce(file,0.0,row_sum,[](double a, double b){ return a+b; },n_threads);
+		}
+
+		/**
+		 * @brief Norm of an in-memory Matrix.
+		 * @param MAT = Matrix
+		 * @param max_norm = False for the Frobenius norm sqrt(sum of squares), true for the max norm (largest absolute value)
+		 */
+		double norm(const std::vector<std::vector<Data1>> &MAT, bool max_norm=false)
+		{
+			double total=0;
+			for(const std::vector<Data1> &row: MAT)
+			{
+				total= max_norm? std::max(total,row_max_abs(row.data(),row.size())) : total+row_sum_squares(row.data(),row.size());
+			}
+			return max_norm? total : std::sqrt(total);
+		}
+
+		/**
+		 * @brief Norm of a Matrix stored in a csv file, computed in one streaming multithreaded pass.
+		 * @param file = "path to A.csv"
+		 * @param max_norm = False for the Frobenius norm sqrt(sum of squares), true for the max norm (largest absolute value)
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		double norm(std::string file, bool max_norm=false, size_t n_threads=0)
+		{
+			if(max_norm)
+			{
+				return stream_reduce(file,0.0,row_max_abs,[](double a, double b){ return std::max(a,b); },n_threads);
+			}
+			return std::sqrt(stream_reduce(file,0.0,row_sum_squares,[](double a, double b){ return a+b; },n_threads));
+		}
+
+		// General Matrix Multiplication
+		/**
+		 * @brief GEMM style multiplication C = alpha * op(A) x op(B) + beta * C, where op(X) is X or its transpose.
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path of C. With beta != 0 the existing C is read from it and accumulated into, otherwise it is simply overwritten.
+		 * @param trans_A = Use the transpose of A
+		 * @param trans_B = Use the transpose of B
+		 * @param alpha = Scale of the product
+		 * @param beta = Scale of the existing C
+		 *
+		 * Overall Working: The transposes are applied while A and B are packed into the zero padded Strassen operands (MATOPS::BigMatrix<Data1>::pad_into),
+		 * so A^T x B or A x B^T costs one load of each file instead of a separate Transpose pass through the disk. The scaling and the accumulation into
+		 * the existing C are done while the result is unpacked, so the common normal equations (A^T A) and gradient (A^T x B + C) computations need a single
+		 * call.
+		 */
+		void gemm(std::string file_1, std::string file_2, std::string path, bool trans_A=false, bool trans_B=false, Data1 alpha=Data1(1), Data1 beta=Data1(0))
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			std::vector<std::vector<Data1>> MAT_1= load_CSV(file_1);
+			std::vector<std::vector<Data1>> MAT_2= load_CSV(file_2);
+
+			// Dimensions of op(A) (m x k) and op(B) (k_2 x n)
+			size_t m= trans_A? MAT_1[0].size() : MAT_1.size();
+			size_t k= trans_A? MAT_1.size() : MAT_1[0].size();
+			size_t k_2= trans_B? MAT_2[0].size() : MAT_2.size();
+			size_t n= trans_B? MAT_2.size() : MAT_2[0].size();
+
+			std::vector<std::vector<Data1>> C_old;
+			try{
+				if(k != k_2)
+				{
+					throw std::runtime_error("Matrix Inner Dimensions don't match !!!");
+				}
+				if(beta!=Data1(0))
+				{
+					C_old=read_CSV(path);
+					if(C_old.size()!=m || C_old[0].size()!=n)
+					{
+						throw std::runtime_error("Dimensions of C don't match the product !!!");
+					}
+				}
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+
+			size_t dim_n=1;
+			while(dim_n<std::max(std::max(m,k),n))
+			{
+				dim_n=dim_n<<1;
+			}
+			Data1** A=Init_matrix(dim_n);
+			Data1** B=Init_matrix(dim_n);
+			pad_into(A,MAT_1,dim_n,trans_A);
+			pad_into(B,MAT_2,dim_n,trans_B);
+			MAT_1.clear();
+			MAT_2.clear();
+
+			Data1** P=StrassenMultiply(A, B, dim_n);
+			Free_matrix(A);
+			Free_matrix(B);
+
+			for(size_t i=0;i<m;i++)
+			{
+				for(size_t j=0;j<n;j++)
+				{
+					P[i][j]= (beta!=Data1(0))? alpha*P[i][j]+beta*C_old[i][j] : alpha*P[i][j];
+				}
+			}
+			bool stored=store_csv<Data1>(P,m,n,path);
+			Free_matrix(P);
+			if(!stored)
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+		}
+
+		#ifdef __linux__
+		// Distributed Matrix Multiplication
+		/**
+		 * @brief Multiply A (file_1) and B (file_2) with the SUMMA algorithm on a 2D grid of local worker processes sharing one POSIX shared memory segment.
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path to store the result
+		 * @param n_workers = No. of worker processes, 0 picks the number of CPUs.
+		 *
+		 * Overall Working: The launcher (calling process) parses A and B into the segment (MATOPS::ShmTransport) and forks n_workers processes arranged as a
+		 * grid_rows x grid_cols grid (as square as n_workers allows). Every worker pins itself to one core, going round robin over the sockets, and copies
+		 * its own block of A, B and C into private memory, so the hot data of every worker is allocated on its own core. The inner dimension is then walked
+		 * in panels of at most SUMMA_PANEL columns: the owner of the A panel of every process row and the owner of the B panel of every process column
+		 * publish their panel, and every worker adds the product of its row and column panels to its C block. Finally the C blocks are gathered into the
+		 * segment and the launcher stores the result. Every call gets its own segment, so calls may run concurrently (also from threads of one process),
+		 * and the workers don't touch the heap after the fork, so the caller may be multithreaded.
+		 */
+		void matmul_distributed(std::string file_1, std::string file_2, std::string path, int n_workers=0)
+		{
+			std::vector<std::vector<Data1>> MAT_1= load_CSV(file_1);
+			std::vector<std::vector<Data1>> MAT_2= load_CSV(file_2);
+			size_t m=MAT_1.size(), k=MAT_1[0].size(), n=MAT_2[0].size();
+			try{
+				if(k != MAT_2.size())
+				{
+					throw "Matrix Inner Dimensions don't match !!! \n";
+				}
+			}catch (const char* msg)
+			{
+				std::cerr<<msg<<'\n';
+				exit(0);
+			}
+
+			if(n_workers<=0)
+			{
+				n_workers=std::max(1,(int)std::thread::hardware_concurrency());
+			}
+			n_workers=(int)std::min<size_t>(n_workers,std::max<size_t>(1,std::min(m,n)*std::min(m,n)));
+			int grid_rows=1;
+			for(int r=1;r*r<=n_workers;r++) // Most square grid_rows x grid_cols factorization
+			{
+				if(n_workers%r==0)
+				{
+					grid_rows=r;
+				}
+			}
+			int grid_cols=n_workers/grid_rows;
+
+			// Start of block b when [0,len) is split into parts blocks.
+			auto split=[](size_t len, int parts, int b){ return len*b/parts; };
+			size_t max_block_rows=(m+grid_rows-1)/grid_rows, max_block_cols=(n+grid_cols-1)/grid_cols;
+			size_t panel_size=SUMMA_PANEL*std::max(max_block_rows,max_block_cols);
+
+			std::unique_ptr<ShmTransport<Data1>> shm;
+			try{
+				// Unique per call: concurrent calls of one process, and a segment left behind by a crashed run of a process with a reused pid, never collide.
+				static std::atomic<unsigned long> calls{0};
+				std::string name="/matops_"+std::to_string(getpid())+"_"+std::to_string(calls++)+"_"
+						+std::to_string((unsigned long long)std::chrono::system_clock::now().time_since_epoch().count());
+				shm.reset(new ShmTransport<Data1>(name,m,k,n,grid_rows,grid_cols,panel_size));
+			}catch (const std::runtime_error &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			Data1* A=shm->at(shm->offset_A);
+			Data1* B=shm->at(shm->offset_B);
+			Data1* C=shm->at(shm->offset_C);
+			for(size_t i=0;i<m;i++)
+			{
+				std::copy(MAT_1[i].begin(),MAT_1[i].end(),A+i*k);
+			}
+			for(size_t i=0;i<k;i++)
+			{
+				std::copy(MAT_2[i].begin(),MAT_2[i].end(),B+i*n);
+			}
+			MAT_1.clear();
+			MAT_2.clear();
+
+			// Panel boundaries: A is split along k by the grid columns, B by the grid rows, a panel never crosses either split.
+			std::vector<size_t> breaks;
+			for(int b=0;b<=grid_cols;b++) breaks.push_back(split(k,grid_cols,b));
+			for(int b=0;b<=grid_rows;b++) breaks.push_back(split(k,grid_rows,b));
+			std::sort(breaks.begin(),breaks.end());
+			breaks.erase(std::unique(breaks.begin(),breaks.end()),breaks.end());
+
+			std::vector<std::vector<int>> sockets=cpu_sockets();
+			std::vector<pid_t> workers;
+
+			// Kill and reap the workers that are still running, the others would wait forever at the next barrier.
+			auto kill_workers=[&workers]{
+				for(pid_t pid: workers)
+				{
+					if(pid>0)
+					{
+						kill(pid,SIGKILL);
+						waitpid(pid,NULL,0);
+					}
+				}
+			};
+
+			for(int w=0;w<n_workers;w++)
+			{
+				pid_t pid=fork();
+				if(pid<0)
+				{
+					kill_workers();
+					shm.reset();
+					std::cerr<<"Can't start worker process\n";
+					exit(0);
+				}
+				if(pid>0)
+				{
+					workers.push_back(pid);
+					continue;
+				}
+
+				// ---- Worker w at grid position (r,c) ----
+				// Nothing may unwind out of the worker into the caller's code, any failure ends the process and the launcher stops the others.
+				// The caller may have other threads, and one of them may hold the heap lock at the fork. The child only gets the forking thread, so
+				// it never calls malloc: its blocks are mapped with mmap, and it ends with _exit.
+				try{
+					int r=w/grid_cols, c=w%grid_cols;
+					if(!sockets.empty())
+					{
+						const std::vector<int> &socket=sockets[w%sockets.size()];
+						cpu_set_t cpus;
+						CPU_ZERO(&cpus);
+						CPU_SET(socket[(w/sockets.size())%socket.size()],&cpus);
+						sched_setaffinity(0,sizeof(cpus),&cpus);
+					}
+					size_t r0=split(m,grid_rows,r), r1=split(m,grid_rows,r+1);   // Rows of A and C owned by the process row
+					size_t c0=split(n,grid_cols,c), c1=split(n,grid_cols,c+1);   // Cols of B and C owned by the process column
+					size_t ak0=split(k,grid_cols,c), ak1=split(k,grid_cols,c+1); // Cols of A owned by this worker
+					size_t bk0=split(k,grid_rows,r), bk1=split(k,grid_rows,r+1); // Rows of B owned by this worker
+					size_t rows=r1-r0, cols=c1-c0;
+
+					// Scatter: private copies of the owned blocks, in anonymous mappings (zero filled) first touched by this worker.
+					auto map_block=[](size_t count){
+						void* block=mmap(NULL,std::max<size_t>(count,1)*sizeof(Data1),PROT_READ|PROT_WRITE,MAP_PRIVATE|MAP_ANONYMOUS,-1,0);
+						if(block==MAP_FAILED)
+						{
+							_exit(1);
+						}
+						return (Data1*)block;
+					};
+					Data1* A_local=map_block(rows*(ak1-ak0));
+					Data1* B_local=map_block((bk1-bk0)*cols);
+					Data1* C_local=map_block(rows*cols);
+					for(size_t i=0;i<rows;i++)
+					{
+						std::copy(A+(r0+i)*k+ak0,A+(r0+i)*k+ak1,A_local+i*(ak1-ak0));
+					}
+					for(size_t i=0;i<bk1-bk0;i++)
+					{
+						std::copy(B+(bk0+i)*n+c0,B+(bk0+i)*n+c1,B_local+i*cols);
+					}
+
+					for(size_t b=0;b+1<breaks.size();b++)
+					{
+						for(size_t s=breaks[b];s<breaks[b+1];s+=SUMMA_PANEL)
+						{
+							size_t e=std::min(breaks[b+1],s+SUMMA_PANEL), width=e-s;
+							Data1* A_panel=shm->row_panel(r); // rows x width
+							Data1* B_panel=shm->col_panel(c); // width x cols
+							if(s>=ak0 && s<ak1) // This worker owns the A panel of its process row
+							{
+								for(size_t i=0;i<rows;i++)
+								{
+									std::copy(A_local+i*(ak1-ak0)+(s-ak0),A_local+i*(ak1-ak0)+(e-ak0),A_panel+i*width);
+								}
+							}
+							if(s>=bk0 && s<bk1) // This worker owns the B panel of its process column
+							{
+								std::copy(B_local+(s-bk0)*cols,B_local+(e-bk0)*cols,B_panel);
+							}
+							shm->barrier();
+							for(size_t i=0;i<rows;i++)
+							{
+								Data1* c_row=C_local+i*cols;
+								for(size_t l=0;l<width;l++)
+								{
+									const Data1 a=A_panel[i*width+l];
+									const Data1* b_row=B_panel+l*cols;
+									for(size_t j=0;j<cols;j++)
+									{
+										c_row[j]+=a*b_row[j];
+									}
+								}
+							}
+							shm->barrier();
+						}
+					}
+
+					// Gather: write the C block back to the segment.
+					for(size_t i=0;i<rows;i++)
+					{
+						std::copy(C_local+i*cols,C_local+(i+1)*cols,C+(r0+i)*n+c0);
+					}
+				}catch (...)
+				{
+					_exit(1);
+				}
+				_exit(0);
+			}
+
+			// Poll the workers: as soon as one fails its peers are blocked at a barrier for good, so the rest are killed.
+			bool failed=false;
+			size_t running=workers.size();
+			while(running>0 && !failed)
+			{
+				bool reaped=false;
+				for(pid_t &pid: workers)
+				{
+					int status=0;
+					if(pid>0 && waitpid(pid,&status,WNOHANG)==pid)
+					{
+						pid=0;
+						running--;
+						reaped=true;
+						failed=failed || !WIFEXITED(status) || WEXITSTATUS(status)!=0;
+					}
+				}
+				if(!reaped)
+				{
+					std::this_thread::sleep_for(std::chrono::milliseconds(1));
+				}
+			}
+			if(failed)
+			{
+				kill_workers();
+				shm.reset();
+				std::cerr<<"A worker process failed\n";
+				exit(0);
+			}
+
+			std::vector<Data1*> C_rows(m);
+			for(size_t i=0;i<m;i++)
+			{
+				C_rows[i]=C+i*n;
+			}
+			if(!store_csv<Data1>(C_rows.data(),m,n,path))
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+		}
+		#endif
+
+		// Matrix Power
+		/**
+		 * @brief Raise a square in-memory Matrix to the power k by repeated squaring, i.e. with O(log k) multiplications.
+		 * @param MAT = Square Matrix A
+		 * @param k = Exponent (A^0 is the identity)
+		 * @param n_threads = No. of worker threads for the parallel Strassen path, 1 runs sequentially and 0 picks the number of hardware threads.
+		 * @param tol = Convergence tolerance, 0 disables early termination.
+		 * @return A^k as a 2D vector.
+		 *
+		 * Overall Working: A is padded once into a dim_n x dim_n buffer and both the running square (A, A^2, A^4, ...) and the running product stay in that
+		 * padded form between steps, so nothing is reloaded or padded again. Every product runs on the parallel StrassenMultiply path. If tol > 0 the
+		 * squaring stops once two consecutive squares differ by at most tol in every element (e.g. the powers of a stochastic matrix converging to its
+		 * stationary matrix S with S x S = S), the remaining factors then reduce to a single product with the converged square.
+		 *
+		 * Throws std::invalid_argument if MAT is not square.
+		 */
+		std::vector<std::vector<Data1>> power(const std::vector<std::vector<Data1>> &MAT, unsigned long long k, size_t n_threads=0, double tol=0)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			size_t n=MAT.size();
+			if(n==0 || MAT[0].size()!=n)
+			{
+				throw std::invalid_argument("Matrix power needs a square Matrix");
+			}
+			size_t dim_n=1;
+			while(dim_n<n)
+			{
+				dim_n=dim_n<<1;
+			}
+
+			ThreadPool pool(n_threads);
+			int parallel_depth=(pool.size()>1)? ((pool.size()>7)? 2 : 1) : 0;
+
+			Data1** base=Init_matrix(dim_n);
+			pad_into(base,MAT,dim_n);
+			Data1** result=NULL; // NULL stands for the identity until the first factor is multiplied in
+
+			auto multiply=[&](Data1** X, Data1** Y){ return StrassenMultiply(X,Y,dim_n,&pool,parallel_depth); };
+			std::vector<std::vector<Data1>> C;
+			try{
+				while(k>0)
+				{
+					if(k&1)
+					{
+						if(result==NULL)
+						{
+							result=Init_matrix(dim_n);
+							for(size_t i=0;i<dim_n;i++)
+							{
+								std::copy(base[i],base[i]+dim_n,result[i]);
+							}
+						}
+						else
+						{
+							Data1** next=multiply(result,base);
+							Free_matrix(result);
+							result=next;
+						}
+					}
+					k>>=1;
+					if(k>0)
+					{
+						Data1** square=multiply(base,base);
+						double diff=0;
+						if(tol>0)
+						{
+							for(size_t i=0;i<n;i++)
+							{
+								for(size_t j=0;j<n;j++)
+								{
+									diff=std::max(diff,std::fabs((double)square[i][j]-(double)base[i][j]));
+								}
+							}
+						}
+						Free_matrix(base);
+						base=square;
+						if(tol>0 && diff<=tol) // Converged: base^m == base for every remaining m >= 1.
+						{
+							if(result==NULL)
+							{
+								result=base;
+								base=NULL;
+							}
+							else
+							{
+								Data1** next=multiply(result,base);
+								Free_matrix(result);
+								result=next;
+							}
+							break;
+						}
+					}
+				}
+
+				C.assign(n,std::vector<Data1>(n,Data1(0)));
+				for(size_t i=0;i<n;i++)
+				{
+					if(result==NULL)
+					{
+						C[i][i]=Data1(1);
+					}
+					else
+					{
+						std::copy(result[i],result[i]+n,C[i].begin());
+					}
+				}
+			}catch (...) // Don't leak the running square and product when a multiplication throws (Eg. std::bad_alloc)
+			{
+				Free_matrix(base);
+				Free_matrix(result);
+				throw;
+			}
+			if(base!=NULL)
+			{
+				Free_matrix(base);
+			}
+			if(result!=NULL)
+			{
+				Free_matrix(result);
+			}
+			return C;
+		}
+
+		/**
+		 * @brief Raise a square Matrix stored in a csv file to the power k and store the result in a csv file. See the in-memory
+		 * MATOPS::BigMatrix<Data1>::power for details.
+		 * @param file = "path to A.csv"
+		 * @param k = Exponent
+		 * @param path = path to store A^k
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @param tol = Convergence tolerance for early termination, 0 disables it.
+		 */
+		void power(std::string file, unsigned long long k, std::string path, size_t n_threads=0, double tol=0)
+		{
+			std::vector<std::vector<Data1>> MAT=load_CSV(file);
+			std::vector<std::vector<Data1>> C;
+			try{
+				C=power(MAT,k,n_threads,tol);
+			}catch (const std::invalid_argument &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			store_csv<Data1>(C,path);
+		}
+
+		// Incremental Matrix Multiplication
+		/**
+		 * @brief An in-memory product C = A x B that is kept up to date by the incremental update functions (MATOPS::BigMatrix<Data1>::update_rows,
+		 * update_cols and update_low_rank) instead of being recomputed from scratch.
+		 */
+		struct Product
+		{
+			std::vector<std::vector<Data1>> A; // m x k
+			std::vector<std::vector<Data1>> B; // k x n
+			std::vector<std::vector<Data1>> C; // m x n, always equal to A x B
+		};
+
+		/**
+		 * @brief Compute A x B once and keep both operands and the result for incremental updates.
+		 * @param MAT_1 = Matrix A (m x k)
+		 * @param MAT_2 = Matrix B (k x n)
+		 * @return The product. Throws std::invalid_argument if the inner dimensions don't match.
+		 */
+		Product make_product(std::vector<std::vector<Data1>> MAT_1, std::vector<std::vector<Data1>> MAT_2)
+		{
+			if(MAT_1.empty() || MAT_2.empty() || MAT_1[0].size()!=MAT_2.size())
+			{
+				throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+			}
+			Product P;
+			P.A=std::move(MAT_1);
+			P.B=std::move(MAT_2);
+			recompute(P.A,P.B,P.C);
+			return P;
+		}
+
+		/**
+		 * @brief Replace some rows of A and recompute only the matching rows of C (row i of C only depends on row i of A). Once more than the
+		 * incremental threshold (see set_incremental_threshold) of the rows changed the whole product is recomputed instead.
+		 * @param P = Product to update
+		 * @param rows = New rows of A, keyed by row index
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 *
+		 * Throws std::invalid_argument if a row index or length doesn't match A.
+		 */
+		void update_rows(Product &P, const std::map<size_t,std::vector<Data1>> &rows, size_t n_threads=0)
+		{
+			size_t m=P.A.size(), k=P.B.size();
+			for(const std::pair<const size_t,std::vector<Data1>> &r: rows)
+			{
+				if(r.first>=m || r.second.size()!=k)
+				{
+					throw std::invalid_argument("Updated row doesn't match the shape of A");
+				}
+				P.A[r.first]=r.second;
+			}
+			if(rows.size()>INCREMENTAL_THRESHOLD*m)
+			{
+				recompute(P.A,P.B,P.C);
+				return;
+			}
+			std::vector<size_t> changed;
+			std::vector<const std::vector<Data1>*> rows_A;
+			for(const std::pair<const size_t,std::vector<Data1>> &r: rows)
+			{
+				changed.push_back(r.first);
+				rows_A.push_back(&P.A[r.first]);
+			}
+			multiply_rows(changed,rows_A,P.B,P.C,n_threads);
+		}
+
+		/**
+		 * @brief Replace some columns of B and recompute only the matching columns of C (column j of C only depends on column j of B). Once more
+		 * than the incremental threshold of the columns changed the whole product is recomputed instead.
+		 * @param P = Product to update
+		 * @param cols = New columns of B, keyed by column index
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 *
+		 * Throws std::invalid_argument if a column index or length doesn't match B.
+		 */
+		void update_cols(Product &P, const std::map<size_t,std::vector<Data1>> &cols, size_t n_threads=0)
+		{
+			size_t m=P.A.size(), k=P.B.size(), n=P.B[0].size();
+			for(const std::pair<const size_t,std::vector<Data1>> &c: cols)
+			{
+				if(c.first>=n || c.second.size()!=k)
+				{
+					throw std::invalid_argument("Updated column doesn't match the shape of B");
+				}
+				for(size_t l=0;l<k;l++)
+				{
+					P.B[l][c.first]=c.second[l];
+				}
+			}
+			if(cols.size()>INCREMENTAL_THRESHOLD*n)
+			{
+				recompute(P.A,P.B,P.C);
+				return;
+			}
+			ThreadPool pool(n_threads);
+			parallel_for(pool,0,m,[&](size_t lo, size_t hi){
+				for(size_t i=lo;i<hi;i++)
+				{
+					for(const std::pair<const size_t,std::vector<Data1>> &c: cols) // The new columns are contiguous, a dot product per element
+					{
+						P.C[i][c.first]=dot_product(P.A[i].data(),c.second.data(),k);
+					}
+				}
+			});
+		}
+
+		/**
+		 * @brief Apply a low rank update U x V (rank r) to A or to B and update C with two thin products instead of a full one:
+		 * (A + U V) B = C + U (V B) and A (B + U V) = C + (A U) V. When r exceeds the incremental threshold times the smallest dimension of the product
+		 * the whole product is recomputed instead.
+		 * @param P = Product to update
+		 * @param U = m x r (update of A) or k x r (update of B)
+		 * @param V = r x k (update of A) or r x n (update of B)
+		 * @param update_B = False to update A, true to update B
+		 *
+		 * Throws std::invalid_argument if the shapes of U and V don't match.
+		 */
+		void update_low_rank(Product &P, const std::vector<std::vector<Data1>> &U, const std::vector<std::vector<Data1>> &V, bool update_B=false)
+		{
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			std::vector<std::vector<Data1>> &X= update_B? P.B : P.A;
+			size_t r=V.size();
+			if(r==0 || U.size()!=X.size() || U[0].size()!=r || V[0].size()!=X[0].size())
+			{
+				throw std::invalid_argument("Shapes of the low rank update don't match the operand");
+			}
+			PadBuffers buffers;
+			std::vector<std::vector<Data1>> UV=multiply_step(U,V,buffers);
+			for(size_t i=0;i<X.size();i++)
+			{
+				for(size_t j=0;j<X[0].size();j++)
+				{
+					X[i][j]+=UV[i][j];
+				}
+			}
+			size_t m=P.A.size(), k=P.B.size(), n=P.B[0].size();
+			if(r>INCREMENTAL_THRESHOLD*std::min(std::min(m,k),n))
+			{
+				Free_pad_buffers(buffers);
+				recompute(P.A,P.B,P.C);
+				return;
+			}
+			std::vector<std::vector<Data1>> D= update_B? multiply_step(multiply_step(P.A,U,buffers),V,buffers)
+													: multiply_step(U,multiply_step(V,P.B,buffers),buffers);
+			Free_pad_buffers(buffers);
+			for(size_t i=0;i<m;i++)
+			{
+				for(size_t j=0;j<n;j++)
+				{
+					P.C[i][j]+=D[i][j];
+				}
+			}
+		}
+
+		/**
+		 * @brief Update the stored product path = A x B after some rows of A (file_1) changed, e.g. between two runs of a pipeline. Only the changed
+		 * rows are read from file_1 (through its row offset index, see MATOPS::BigMatrix<Data1>::load_submatrix) and only the matching rows of the
+		 * previous result are recomputed. The full product is recomputed (MATOPS::BigMatrix<Data1>::matmul) when there is no previous result of the
+		 * right shape or when the changed fraction of rows exceeds the incremental threshold.
+		 * @param file_1 = "path to the updated A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path of the previous result, overwritten with the updated one
+		 * @param changed_rows = Indices of the rows of A that changed, repeats are ignored. An index outside of A is an error.
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void matmul_update(std::string file_1, std::string file_2, std::string path, const std::vector<size_t> &changed_rows, size_t n_threads=0)
+		{
+			std::vector<size_t> targets;
+			std::vector<std::vector<Data1>> rows, B, C;
+			try{
+				CsvIndex index=CsvIndex::open(file_1);
+				size_t prev_rows=0, prev_cols=0, k=0, n=0;
+				csv_shape(file_2,k,n);
+				std::error_code err;
+				if(std::filesystem::exists(path,err))
+				{
+					csv_shape(path,prev_rows,prev_cols);
+				}
+				if(index.cols()!=k)
+				{
+					throw std::runtime_error("Matrix Inner Dimensions don't match !!!");
+				}
+				// Repeated indices count once towards the threshold.
+				targets.assign(changed_rows.begin(),changed_rows.end());
+				std::sort(targets.begin(),targets.end());
+				targets.erase(std::unique(targets.begin(),targets.end()),targets.end());
+				if(!targets.empty() && targets.back()>=index.rows())
+				{
+					throw std::invalid_argument("Changed row is outside of A in '"+file_1+"'");
+				}
+				if(prev_rows!=index.rows() || prev_cols!=n || targets.size()>INCREMENTAL_THRESHOLD*index.rows())
+				{
+					matmul(file_1,file_2,path);
+					return;
+				}
+				std::ifstream indata(file_1,std::ios::binary); // Opened once, every changed row is a seek through the index
+				if(indata.fail())
+				{
+					throw std::runtime_error("File path: '"+file_1+"' doesn't exist");
+				}
+				for(size_t i: targets)
+				{
+					std::vector<std::vector<Data1>> row=read_rows(indata,index,i,i+1,0,k);
+					if(row.size()!=1 || row[0].size()!=k)
+					{
+						throw std::runtime_error("Row doesn't match the shape of A in '"+file_1+"'");
+					}
+					rows.push_back(std::move(row[0]));
+				}
+				indata.close();
+				B=read_CSV(file_2);
+				C=read_CSV(path);
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			std::vector<const std::vector<Data1>*> rows_A;
+			for(const std::vector<Data1> &row: rows)
+			{
+				rows_A.push_back(&row);
+			}
+			multiply_rows(targets,rows_A,B,C,n_threads);
+			if(!store_csv<Data1>(C,path))
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+		}
+
+		// Complex Matrix Multiplication
+		/**
+		 * @brief A complex Matrix in planar storage: the real and the imaginary parts are kept as two real Matrices, so the real multiplication kernels
+		 * (StrassenMultiply and the leaf kernels) run on them directly. Used by MATOPS::BigMatrix<Data1>::multiply_complex and matmul_complex.
+		 */
+		struct ComplexMatrix
+		{
+			std::vector<std::vector<Data1>> re; // Real parts
+			std::vector<std::vector<Data1>> im; // Imaginary parts
+
+			/**
+			 * @brief Split an interleaved Matrix of std::complex values into planes.
+			 */
+			static ComplexMatrix from_interleaved(const std::vector<std::vector<std::complex<Data1>>> &MAT)
+			{
+				ComplexMatrix Z;
+				Z.re.resize(MAT.size());
+				Z.im.resize(MAT.size());
+				for(size_t i=0;i<MAT.size();i++)
+				{
+					Z.re[i].resize(MAT[i].size());
+					Z.im[i].resize(MAT[i].size());
+					for(size_t j=0;j<MAT[i].size();j++)
+					{
+						Z.re[i][j]=MAT[i][j].real();
+						Z.im[i][j]=MAT[i][j].imag();
+					}
+				}
+				return Z;
+			}
+
+			/**
+			 * @brief Join the planes into an interleaved Matrix of std::complex values.
+			 */
+			std::vector<std::vector<std::complex<Data1>>> to_interleaved() const
+			{
+				std::vector<std::vector<std::complex<Data1>>> MAT(re.size());
+				for(size_t i=0;i<re.size();i++)
+				{
+					MAT[i].resize(re[i].size());
+					for(size_t j=0;j<re[i].size();j++)
+					{
+						MAT[i][j]=std::complex<Data1>(re[i][j],im[i][j]);
+					}
+				}
+				return MAT;
+			}
+		};
+
+		/**
+		 * @brief Function to load a complex Matrix from a .csv file whose cells are written as "a+bi" (see MATOPS::parse_complex). The cells are parsed
+		 * straight into the real and imaginary planes.
+		 * @param path = "path to Z.csv"
+		 * @return The Matrix. Throws std::runtime_error if the file doesn't exist or holds an invalid cell.
+		 */
+		ComplexMatrix load_complex(const std::string &path)
+		{
+			std::ifstream indata;
+			indata.open(path);
+			if(indata.fail())
+			{
+				throw std::runtime_error("File path: '"+path+"' doesn't exist");
+			}
+			ComplexMatrix Z;
+			std::string line="";
+			while(getline(indata,line))
+			{
+				if(line.empty())
+				{
+					continue;
+				}
+				std::stringstream lineStream(line);
+				std::string cell;
+				std::vector<Data1> re, im;
+				while(std::getline(lineStream,cell,','))
+				{
+					Data1 a, b;
+					parse_complex<Data1>(cell,a,b);
+					re.push_back(a);
+					im.push_back(b);
+				}
+				Z.re.push_back(std::move(re));
+				Z.im.push_back(std::move(im));
+			}
+			indata.close();
+			return Z;
+		}
+
+		/**
+		 * @brief Function to store a complex Matrix in a .csv file with "a+bi" cells.
+		 * @param Z = Matrix to store
+		 * @param path = "path to destination csv file"
+		 * @return Returns false if the destination file could not be opened or written.
+		 */
+		bool store_complex(const ComplexMatrix &Z, const std::string &path)
+		{
+			std::ofstream file;
+			file.open(path);
+			if(file.fail())
+			{
+				return false;
+			}
+			for(size_t i=0;i<Z.re.size();i++)
+			{
+				for(size_t j=0;j<Z.re[i].size();j++)
+				{
+					file<<format_complex(Z.re[i][j],Z.im[i][j])<<((j+1<Z.re[i].size())? ",":"\n");
+				}
+			}
+			file.close();
+			return !file.fail();
+		}
+
+		/**
+		 * @brief Multiply two complex Matrices in planar storage with the 3M method: three real products instead of four,
+		 * T1 = Ar Br, T2 = Ai Bi, T3 = (Ar + Ai)(Br + Bi), then Re(C) = T1 - T2 and Im(C) = T3 - T1 - T2. Every real product goes through multiply_step
+		 * (StrassenMultiply with the parallel top levels, or the classical product for small shapes), so the complex product costs 3/4 of the real
+		 * multiply work of the 4M method. The imaginary part is formed by a subtraction, which can lose some relative accuracy when it is much smaller
+		 * than the real part.
+		 * @param A = Matrix A (m x k)
+		 * @param B = Matrix B (k x n)
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @return A x B. Throws std::invalid_argument if the shapes don't match.
+		 */
+		ComplexMatrix multiply_complex(const ComplexMatrix &A, const ComplexMatrix &B, size_t n_threads=0)
+		{
+			static_assert(std::is_floating_point<Data1>::value,"Complex multiplication needs a floating point Data1 (float or double)");
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			if(A.re.empty() || B.re.empty() || A.im.size()!=A.re.size() || B.im.size()!=B.re.size() || A.re[0].size()!=B.re.size())
+			{
+				throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+			}
+			ThreadPool pool(n_threads);
+			PadBuffers buffers;
+			Expression plus;
+			plus.beta=Data1(1);
+			ComplexMatrix C;
+			{
+				std::vector<std::vector<Data1>> A_sum=evaluate(plus,&A.re,&A.im,NULL,pool);
+				std::vector<std::vector<Data1>> B_sum=evaluate(plus,&B.re,&B.im,NULL,pool);
+				C.im=block_product(A_sum,B_sum,buffers,pool); // T3
+			}
+			std::vector<std::vector<Data1>> T1=block_product(A.re,B.re,buffers,pool);
+			std::vector<std::vector<Data1>> T2=block_product(A.im,B.im,buffers,pool);
+			Free_pad_buffers(buffers);
+
+			C.re.resize(T1.size());
+			parallel_for(pool,0,T1.size(),[&](size_t lo, size_t hi){
+				for(size_t i=lo;i<hi;i++)
+				{
+					const Data1* t1=T1[i].data();
+					const Data1* t2=T2[i].data();
+					Data1* im=C.im[i].data();
+					C.re[i].resize(T1[i].size());
+					Data1* re=C.re[i].data();
+					for(size_t j=0;j<T1[i].size();j++)
+					{
+						re[j]=t1[j]-t2[j];
+						im[j]-=t1[j]+t2[j];
+					}
+				}
+			});
+			return C;
+		}
+
+		/**
+		 * @brief Multiply two complex Matrices stored in .csv files with "a+bi" cells (see MATOPS::BigMatrix<Data1>::multiply_complex) and store the
+		 * result in the same format.
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path to store the result
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void matmul_complex(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			ComplexMatrix C;
+			try{
+				C=multiply_complex(load_complex(file_1),load_complex(file_2),n_threads);
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			if(!store_complex(C,path))
+			{
+				std::cerr<<"Can't write to file path: '"<<path<<"'\n";
+				exit(0);
+			}
+		}
+
+		// LU Factorization, Linear Solve and Inverse
+		/**
+		 * @brief LU factorization P A = L U of a square Matrix, see MATOPS::BigMatrix<Data1>::lu.
+		 */
+		struct LUFactors
+		{
+			std::vector<std::vector<Data1>> LU; // L (strictly below the diagonal, unit diagonal implied) and U (on and above the diagonal)
+			std::vector<size_t> perm; // Row i of P A is row perm[i] of A
+		};
 
-		    std::vector<std::vector<Data1>> dataList;
-		    std::string line = "";
+		/**
+		 * @brief Recursive block LU factorization with partial pivoting P A = L U of a square in-memory Matrix (float or double).
+		 * @param MAT = Square Matrix A
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @return The factors. Throws std::invalid_argument if A is not square and std::runtime_error if it is singular.
+		 *
+		 * Overall Working: The columns are split in halves recursively. After factoring the left half, the top right block is solved with a recursive
+		 * triangular solve and the Schur complement update A22 -= A21 x A12 goes through StrassenMultiply (multithreaded for the top recursion levels),
+		 * so the factorization inherits the O(n^2.8) cost of the multiplication. Panels of at most LU_LEAF columns are factored directly.
+		 */
+		LUFactors lu(const std::vector<std::vector<Data1>> &MAT, size_t n_threads=0)
+		{
+			static_assert(std::is_floating_point<Data1>::value,"LU factorization needs a floating point Data1 (float or double)");
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			size_t n=MAT.size();
+			for(const std::vector<Data1> &row: MAT)
+			{
+				if(row.size()!=n)
+				{
+					throw std::invalid_argument("LU factorization needs a square Matrix");
+				}
+			}
+			LUFactors F;
+			F.LU=MAT;
+			F.perm.resize(n);
+			for(size_t i=0;i<n;i++)
+			{
+				F.perm[i]=i;
+			}
+			ThreadPool pool(n_threads);
+			PadBuffers buffers;
+			try{
+				lu_panel(F.LU,0,n,F.perm,buffers,pool);
+			}catch (...)
+			{
+				Free_pad_buffers(buffers);
+				throw;
+			}
+			Free_pad_buffers(buffers);
+			return F;
+		}
 
-		    while(getline(indata,line))
-		    {
-		        std::stringstream lineStream(line);
-		        std::string cell;
-		        std::vector<Data1> temp;
-		        while (std::getline(lineStream,cell,','))
-		        {
-		            temp.push_back(convert_to<Data1>(cell)); // convert from string to Data1 and store it in an 2D array.
-		        }
-		        dataList.push_back(temp);
+		/**
+		 * @brief Solve T X = B for a triangular in-memory Matrix T and several right hand sides (the columns of B).
+		 * @param T = n x n triangular Matrix, only its lower (or upper) triangle is read
+		 * @param B = n x r right hand sides
+		 * @param lower = T is lower (true) or upper (false) triangular
+		 * @param unit = T has a unit diagonal, the stored diagonal is not read
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 * @return X. Throws std::invalid_argument if the shapes don't match.
+		 */
+		std::vector<std::vector<Data1>> triangular_solve(const std::vector<std::vector<Data1>> &T, std::vector<std::vector<Data1>> B, bool lower,
+				bool unit=false, size_t n_threads=0)
+		{
+			static_assert(std::is_floating_point<Data1>::value,"Triangular solve needs a floating point Data1 (float or double)");
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			size_t n=T.size();
+			for(const std::vector<Data1> &row: T)
+			{
+				if(row.size()!=n)
+				{
+					throw std::invalid_argument("Triangular solve needs a square Matrix");
+				}
+			}
+			if(B.size()!=n)
+			{
+				throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+			}
+			ThreadPool pool(n_threads);
+			PadBuffers buffers;
+			triangular_block_solve(T,0,n,B,0,lower,unit,buffers,pool);
+			Free_pad_buffers(buffers);
+			return B;
+		}
 
-		    }
-		    indata.close(); // Close file
-		    return dataList; // Return the 2D vector 
+		/**
+		 * @brief Solve A X = B with the LU factors of A (see MATOPS::BigMatrix<Data1>::lu) for several right hand sides (the columns of B).
+		 * @return X. Throws std::invalid_argument if B doesn't have as many rows as A.
+		 */
+		std::vector<std::vector<Data1>> solve(const LUFactors &F, const std::vector<std::vector<Data1>> &B, size_t n_threads=0)
+		{
+			static_assert(std::is_floating_point<Data1>::value,"Linear solve needs a floating point Data1 (float or double)");
+			#ifndef SET_LEAF_SIZE
+				set_configerd_Leaf_size();
+			#endif
+			size_t n=F.LU.size();
+			if(B.size()!=n)
+			{
+				throw std::invalid_argument("Matrix Inner Dimensions don't match !!!");
+			}
+			std::vector<std::vector<Data1>> X(n);
+			for(size_t i=0;i<n;i++)
+			{
+				X[i]=B[F.perm[i]];
+			}
+			ThreadPool pool(n_threads);
+			PadBuffers buffers;
+			triangular_block_solve(F.LU,0,n,X,0,true,true,buffers,pool);
+			triangular_block_solve(F.LU,0,n,X,0,false,false,buffers,pool);
+			Free_pad_buffers(buffers);
+			return X;
 		}
 
 		/**
-		 * @brief Function to print a Matrix from a .csv file.
-		 * @param path = "path to .csv i.e. to be printed"
+		 * @brief Solve A X = B for a square in-memory Matrix A and several right hand sides (the columns of B), through the LU factorization of A.
+		 * @return X. Throws std::invalid_argument if the shapes don't match and std::runtime_error if A is singular.
 		 */
-			public:
-		void Mat_print(std::string path)
+		std::vector<std::vector<Data1>> solve(const std::vector<std::vector<Data1>> &MAT_1, const std::vector<std::vector<Data1>> &MAT_2, size_t n_threads=0)
 		{
-			std::vector<std::vector<Data1>> MAT= load_CSV(path);
+			return solve(lu(MAT_1,n_threads),MAT_2,n_threads);
+		}
 
-			for(std::vector<Data1> a: MAT)
+		/**
+		 * @brief Inverse of a square in-memory Matrix, i.e. the solution of A X = I through the LU factorization of A.
+		 * @return The inverse. Throws std::invalid_argument if A is not square and std::runtime_error if it is singular.
+		 */
+		std::vector<std::vector<Data1>> inverse(const std::vector<std::vector<Data1>> &MAT, size_t n_threads=0)
+		{
+			LUFactors F=lu(MAT,n_threads);
+			std::vector<std::vector<Data1>> I(MAT.size(),std::vector<Data1>(MAT.size(),Data1(0)));
+			for(size_t i=0;i<I.size();i++)
 			{
-				for(Data1 i: a)
+				I[i][i]=Data1(1);
+			}
+			return solve(F,I,n_threads);
+		}
+
+		/**
+		 * @brief LU factorization with partial pivoting P A = L U of a square Matrix stored in a csv file.
+		 * @param file = "path to A.csv"
+		 * @param path_L = path to store L (unit lower triangular)
+		 * @param path_U = path to store U (upper triangular)
+		 * @param path_P = path to store the permutation as a column: row i of P A is row perm[i] (0 based) of A
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void lu(std::string file, std::string path_L, std::string path_U, std::string path_P, size_t n_threads=0)
+		{
+			std::vector<std::vector<Data1>> MAT=load_CSV(file);
+			LUFactors F;
+			try{
+				F=lu(MAT,n_threads);
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			MAT.clear();
+			size_t n=F.LU.size();
+			std::vector<std::vector<Data1>> L(n,std::vector<Data1>(n,Data1(0)));
+			for(size_t i=0;i<n;i++)
+			{
+				std::copy(F.LU[i].begin(),F.LU[i].begin()+i,L[i].begin());
+				L[i][i]=Data1(1);
+				std::fill(F.LU[i].begin(),F.LU[i].begin()+i,Data1(0));
+			}
+			std::vector<std::vector<size_t>> P(n,std::vector<size_t>(1));
+			for(size_t i=0;i<n;i++)
+			{
+				P[i][0]=F.perm[i];
+			}
+			if(!store_csv<Data1>(L,path_L) || !store_csv<Data1>(F.LU,path_U) || !store_csv<size_t>(P,path_P))
+			{
+				std::cerr<<"Can't write the LU factors\n";
+				exit(0);
+			}
+		}
+
+		/**
+		 * @brief Solve A X = B for a square Matrix A and several right hand sides (the columns of B) stored in csv files, through the LU factorization
+		 * of A (see MATOPS::BigMatrix<Data1>::lu).
+		 * @param file_1 = "path to A.csv"
+		 * @param file_2 = "path to B.csv"
+		 * @param path = path to store X
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void solve(std::string file_1, std::string file_2, std::string path, size_t n_threads=0)
+		{
+			std::vector<std::vector<Data1>> MAT_1=load_CSV(file_1);
+			std::vector<std::vector<Data1>> MAT_2=load_CSV(file_2);
+			std::vector<std::vector<Data1>> X;
+			try{
+				X=solve(MAT_1,MAT_2,n_threads);
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			store_csv<Data1>(X,path);
+		}
+
+		/**
+		 * @brief Inverse of a square Matrix stored in a csv file, through its LU factorization.
+		 * @param file = "path to A.csv"
+		 * @param path = path to store the inverse
+		 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+		 */
+		void inverse(std::string file, std::string path, size_t n_threads=0)
+		{
+			std::vector<std::vector<Data1>> MAT=load_CSV(file);
+			std::vector<std::vector<Data1>> X;
+			try{
+				X=inverse(MAT,n_threads);
+			}catch (const std::exception &err)
+			{
+				std::cerr<<err.what()<<'\n';
+				exit(0);
+			}
+			store_csv<Data1>(X,path);
+		}
+
+		// Matrix Transpose function begins here
+
+		/**
+		 *
+		 * @brief This is a function to find the Transpose of a BigMatrix and stores it in a csv file.
+		 * @param path = "path/to/A.csv"
+		 * @param str_path = path to store the Transpose of BigMatrix A.
+		 *
+		 */
+		void Transpose(std::string path, std::string str_path)
+		{
+			cached("Transpose",{path},str_path,[&]{ Transpose_uncached(path,str_path); });
+		}
+
+		/**
+		 * @brief The body of MATOPS::BigMatrix<Data1>::Transpose without the result cache lookup.
+		 */
+		void Transpose_uncached(std::string path, std::string str_path)
+			{
+			    std::vector<std::vector<Data1>> MAT= load_CSV(path); // Load the Matrix from CSV file
+
+			    Data1** A= Init_matrix(MAT[0].size(),MAT.size());
+
+				for(size_t i=0;i<MAT.size();i++)
 				{
-					std::cout<< i <<" ";
+					for(size_t j=0;j<MAT[0].size();j++)
+					{
+						A[j][i]=MAT[i][j];
+					}
 				}
-				std::cout<<'\n';
+
+				store_csv<Data1>(A,MAT[0].size(),MAT.size(),str_path);
+				Free_matrix(A);
 			}
+
+		/**
+		 * @brief This is a function to find the Transpose of a BigMatrix and stores it in the same csv file (In-palce transpose).
+		 * @param path = "path/to/A.csv"
+		 */
+		void Transpose(std::string path)
+		{
+			cached("Transpose",{path},path,[&]{ Transpose_uncached(path); });
 		}
-		
-		/** 
-		 * @brief This Function sets the LEAF_SIZE i.e. the array size at which we shift from Strassan's Algo to normal O(n^3) solution, this prevents the 
-		 * StrassenMultiply recursion function from down to a leaf size/Matrix size of 1. Once we reach a square matrix array of size LEAF_SIZE x LEAF_SIZE 
-		 * or lesser, we perform the multiplication using the naive O(n^3) time complexity solution. 
-		 * 
-		 * 		A very high value of LEAF_SIZE leads to lesser recursion calls but ends up giving more weightage to the O(n^3) solution, thus suffer high 
-		 * 		execution time. 
-		 * 
-		 * 		On the other hand a very low LEAF_SIZE value leads to higher number of resursion calls and gives lesser weightage to the O(n^3) solution, 
-		 * 		which again leads to high execution time. 
-		 * 
-		 * Hence an optimal LEAF_SIZE value has to be found that gives the minimum execution time by finding a trade off between the O(n^3) solution and recurssion 
-		 * calls. This indirectly implies that the value of LEAF_SIZE vary from one machine to another, thus we need to experimentally find out this value for each 
-		 * machine and configure the matrix.h library accordingly. This experimentation is done by the configure_lib.cpp, which raises the SET_LEAF_SIZE flag 
-		 * (thus activating the set_LEAF_SIZE() function) during execution, as a result of which the "matrix.h" library is called (in its configuration mode) by 
-		 * configure_lib.cpp. This allows configure_lib.cpp to manipulate the LEAF_SIZE (private variable) of the matrix.h file. Hence configure.cpp can test the 
-		 * hardware for different values of LEAF_SIZE and pick its optimal (i.e. the value that gives the lowest execution time) value and finally store the optimal 
-		 * value in the configure.txt file. 
-		 * 
+
+		/**
+		 * @brief The body of the in-place MATOPS::BigMatrix<Data1>::Transpose without the result cache lookup.
 		 */
-		#ifdef SET_LEAF_SIZE 
-		void set_LEAF_SIZE(int leaf_size)
+		void Transpose_uncached(std::string path)
+					{
+					    std::vector<std::vector<Data1>> MAT= load_CSV(path); // Load the Matrix from CSV file
+
+					    Data1** A= Init_matrix(MAT[0].size(),MAT.size());
+
+						for(size_t i=0;i<MAT.size();i++)
+						{
+							for(size_t j=0;j<MAT[0].size();j++)
+							{
+								A[j][i]=MAT[i][j];
+							}
+						}
+
+						store_csv<Data1>(A,MAT[0].size(),MAT.size(),path);
+						store_csv<Data1>(A,MAT[0].size(),MAT.size(),path);
+
+						Free_matrix(A);
+
+					}
+
+			};
+
+		#ifdef __linux__
+		/**
+		 * @brief Header of a Matrix stored in a POSIX shared memory segment by MATOPS::store_shm, followed by the rows x cols elements in row major order.
+		 */
+		struct ShmMatrixHeader
 		{
-			LEAF_SIZE=leaf_size;
+			uint64_t magic;
+			uint64_t rows;
+			uint64_t cols;
+			uint64_t element_size;
+			uint64_t floating_point;
+		};
+
+		const uint64_t SHM_MATRIX_MAGIC=0x4d41544f50534d31ULL; // "MATOPSM1"
+
+		/**
+		 * @brief Store a Matrix in a new POSIX shared memory segment, Eg. to hand an operand to a MATOPS::MatmulService without going through a csv file.
+		 * @tparam T = DataType of the Matrix
+		 * @param name = Name of the segment, Eg. "/my_operand". An existing segment of that name is replaced.
+		 * @param MAT = Matrix
+		 *
+		 * Throws std::runtime_error if the segment can't be created.
+		 */
+		template<typename T>
+		void store_shm(const std::string &name, const std::vector<std::vector<T>> &MAT)
+		{
+			size_t rows=MAT.size(), cols=MAT.empty()? 0 : MAT[0].size();
+			size_t bytes=sizeof(ShmMatrixHeader)+rows*cols*sizeof(T);
+			shm_unlink(name.c_str());
+			int fd=shm_open(name.c_str(),O_CREAT|O_EXCL|O_RDWR,0600);
+			if(fd<0)
+			{
+				throw std::runtime_error("Can't create shared memory segment '"+name+"'");
+			}
+			if(ftruncate(fd,bytes)!=0)
+			{
+				close(fd);
+				shm_unlink(name.c_str());
+				throw std::runtime_error("Can't size shared memory segment '"+name+"'");
+			}
+			void* base=mmap(NULL,bytes,PROT_READ|PROT_WRITE,MAP_SHARED,fd,0);
+			close(fd);
+			if(base==MAP_FAILED)
+			{
+				shm_unlink(name.c_str());
+				throw std::runtime_error("Can't map shared memory segment '"+name+"'");
+			}
+			ShmMatrixHeader* header=(ShmMatrixHeader*)base;
+			*header={SHM_MATRIX_MAGIC,rows,cols,sizeof(T),std::is_floating_point<T>::value? 1ULL : 0ULL};
+			T* data=(T*)(header+1);
+			for(size_t i=0;i<rows;i++)
+			{
+				if(MAT[i].size()!=cols)
+				{
+					munmap(base,bytes);
+					shm_unlink(name.c_str());
+					throw std::runtime_error("Rows of different length in Matrix for '"+name+"'");
+				}
+				std::copy(MAT[i].begin(),MAT[i].end(),data+i*cols);
+			}
+			munmap(base,bytes);
 		}
-		#else
+
 		/**
-		 * @brief When matrix.h is normally called i.e. without any SET_LEAF_SIZE flag, set_configerd_Leaf_size() function gets activated (set_LEAFT_SIZE() function
-		 * gets deactivated). The set_configerd_Leaf_size() function searches for the configure.txt file (generated earlier by configure_lib.cpp during the configuration
-		 * process) and sets the optimal value of LEAF_SIZE. This function is called by the  MATOPS::BigMatrix<Data1>::matmul before starting the multiplication process.
-		 * 
+		 * @brief Load a Matrix from a POSIX shared memory segment written by MATOPS::store_shm.
+		 * @tparam T = DataType of the Matrix, must match the type it was stored with
+		 * @param name = Name of the segment
+		 * @param unlink = Remove the segment after reading it
+		 * @return The Matrix. Throws std::runtime_error if the segment doesn't exist or holds another datatype.
 		 */
-		void set_configerd_Leaf_size()
+		template<typename T>
+		std::vector<std::vector<T>> load_shm(const std::string &name, bool unlink=false)
 		{
-			std::ifstream indata;
-			indata.open("configure.txt");
-			std::string str="";
-			getline(indata,str);
-			indata.close();
-			LEAF_SIZE=std::stoi(str);
+			int fd=shm_open(name.c_str(),O_RDONLY,0);
+			if(fd<0)
+			{
+				throw std::runtime_error("Shared memory segment '"+name+"' doesn't exist");
+			}
+			struct stat st;
+			if(fstat(fd,&st)!=0 || (size_t)st.st_size<sizeof(ShmMatrixHeader))
+			{
+				close(fd);
+				throw std::runtime_error("Shared memory segment '"+name+"' doesn't hold a Matrix");
+			}
+			void* base=mmap(NULL,st.st_size,PROT_READ,MAP_SHARED,fd,0);
+			close(fd);
+			if(base==MAP_FAILED)
+			{
+				throw std::runtime_error("Can't map shared memory segment '"+name+"'");
+			}
+			const ShmMatrixHeader* header=(const ShmMatrixHeader*)base;
+			bool valid=header->magic==SHM_MATRIX_MAGIC && header->element_size==sizeof(T) && header->floating_point==(std::is_floating_point<T>::value? 1ULL : 0ULL)
+				&& sizeof(ShmMatrixHeader)+header->rows*header->cols*sizeof(T)<=(size_t)st.st_size;
+			std::vector<std::vector<T>> MAT;
+			if(valid)
+			{
+				const T* data=(const T*)(header+1);
+				MAT.resize(header->rows);
+				for(size_t i=0;i<header->rows;i++)
+				{
+					MAT[i].assign(data+i*header->cols,data+(i+1)*header->cols);
+				}
+			}
+			munmap(base,st.st_size);
+			if(!valid)
+			{
+				throw std::runtime_error("Shared memory segment '"+name+"' doesn't hold a Matrix of this datatype");
+			}
+			if(unlink)
+			{
+				shm_unlink(name.c_str());
+			}
+			return MAT;
 		}
-		#endif
 
-		// Matrix Multiplication from CSV files
 		/**
-		 * @brief This is the BigMatrix multiplication Function that multiplies two matrices A and B stored in A.csv and B.csv respectively and store the result in C.csv file.
-		 * Before beginning the multiplication process it calls the MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size() function to parses the configure.txt (generated by 
-		 * configure_lib.cpp during the configuration process) and sets the optimal LEAF_SIZE value.
-		 * @param file_1 = "path to A.csv"
-		 * @param file_2 = "path to B.csv"
-		 * @param path = path to a store file (no need to predefine C.csv file in the directory, it gets generated automatically.)
-		 * @param print = True, To see all the Matrices i.e. A,B and C in the output terminal/stdio.
-		 * 
-		 * Overall Working: When matmul is called, it first sets the the optimal LEAF_SIZE value. It then loads the two csv files from "path to A.csv" and "path to B.csv"
-		 * directories into two 2D vectors namely MAT_1 and MAT_2 of type Data1 using MATOPS::BigMatrix<Data1>::load_CSV function. The dimensions of both the matrices are determined 
-		 * from MAT_1 and MAT_2 say m_1,n_1 ad m_2,n_2 respectively. If the inner dimensions of both MAT_1 and MAT_2 don't match an error is thrown and the program is exited. If the 
-		 * inner dimensions match then we proceed for Multiplication. Before calling the MATOPS::BigMatrix<Data1>::StrassenMultiply fuction, we pad the matrices with zeros to make both
-		 * MAT_1 and MAT_2 square matrices of equal dimension, dim_n. Where dim_n is a power of 2 i.e. greater than or equal to max(m_1,n_1,n_2) or max(m_1,m_2,n_2) (since n_1=m_2). We 
-		 * callocate (by calling MATOPS::BigMatrix<Data1>::Init_matrix(dim_n) two chunk of memory of size dim_n x dim_n pointed by pointers A and B. Finally  we build the Zero padded square
-		 * Matrices by copying the contents from from MAT_1 and MAT_2 into the memory (pointed by A and B) respectively. These Memory addresses and dim_n are then passed on to the 
-		 * MATOPS::BigMatrix<Data1>::StrassenMultiply function to evaluate the product of A and B. The MATOPS::BigMatrix<Data1>::StrassenMultiply() func returns a pointer pointing 
-		 * to a location in the memory where the answer is stored. This memory address is then passed to the MATOPS::BigMatrix<Data1>::store_csv() along with the resultant matrix 
-		 * dimension (i.e. m_1 x n_2) and the storage destination path to store the final result in a csv file.
-		 * 
-		 * Finally all the callocated memories are freed up using the free command.
-		 * 	
+		 * @brief Latency and throughput counters of a MATOPS::MatmulService.
 		 */
-		void matmul(std::string file_1, std::string file_2, std::string path, bool print=false)
+		struct ServiceStats
+		{
+			size_t requests=0;        // Requests answered (including errors)
+			size_t errors=0;          // Requests answered with ERR
+			size_t operand_hits=0;    // File operands served from the warm operand cache
+			size_t operand_misses=0;  // File operands parsed
+			double total_latency=0;   // Sum of the request latencies in seconds
+			double max_latency=0;     // Largest request latency in seconds
+			double flops=0;           // Floating point operations of all the multiplications (2 m k n each)
+			double compute_time=0;    // Time spent multiplying and transposing in seconds
+		};
 
-				{   
-					
-					#ifndef SET_LEAF_SIZE 
-						set_configerd_Leaf_size(); // Set the optimal LEAF_SIZE by parsing the configuration file genrated by configure_lib.cpp.
-					#endif
-					// std::cout<<"Current LEAF_SIZE value: "<<LEAF_SIZE<<'\n'; // Just a check to see what LEAF_SIZE value is being used
-					
-					// Parse the CSV files and get the Matrices to be multiplied
+		/**
+		 * @brief A resident multiplication service: a daemon listening on a Unix domain socket that runs multiply and transpose requests, so that small
+		 * jobs don't pay for process startup, configure.txt, thread creation and parsing of operands that didn't change.
+		 * @tparam Data1 = DataType of the Matrices
+		 *
+		 * Protocol: one request per line, fields separated by tabs, one reply line per request ("OK ..." or "ERR <message>"):
+		 * - MATMUL <A> <B> <C>: C = A x B, replies "OK <rows> <cols> <seconds>"
+		 * - TRANSPOSE <A> <C>: C = A^T, replies "OK <rows> <cols> <seconds>"
+		 * - STATS: replies "OK" followed by key=value counters (see MATOPS::ServiceStats)
+		 * - PING: replies "OK"
+		 * - SHUTDOWN: replies "OK" and stops the service
+		 *
+		 * Operands and results are "file:<path>" (csv, a bare path means the same) or "shm:<name>" (shared memory segment, see MATOPS::store_shm and
+		 * MATOPS::load_shm). Kept warm between requests: the LEAF_SIZE (configure.txt is read once), one MATOPS::ThreadPool, the padded Strassen operand
+		 * buffers, and parsed file operands (up to operand_cache_bytes, evicted least recently used first and reparsed when the file's size or
+		 * modification time changed). Multiplications run one at a time, each on the whole pool.
+		 */
+		template<typename Data1>
+		class MatmulService
+		{
+			typedef std::vector<std::vector<Data1>> Operand;
+
+			struct CachedOperand
+			{
+				uintmax_t size;
+				long long mtime;
+				std::shared_ptr<const Operand> MAT;
+				size_t bytes;
+				size_t last_use;
+			};
 
-					std::vector<std::vector<Data1>> MAT_1= load_CSV(file_1);
-					std::vector<std::vector<Data1>> MAT_2= load_CSV(file_2);
+			std::string socket_path;
+			BigMatrix<Data1> engine;
+			ThreadPool pool;
+			typename BigMatrix<Data1>::PadBuffers buffers;
+			std::mutex compute_mutex;  // Guards engine and buffers
 
-					// Get the dimensions of both the Matrices.
-					int m_1=MAT_1.size(), n_1=MAT_1[0].size();  // Matrix 1 M,N
-					int m_2=MAT_2.size(), n_2=MAT_2[0].size(); // Matrix 2 M,N
+			std::map<std::string,CachedOperand> operands;
+			size_t operand_cache_bytes;
+			size_t operand_bytes=0;
+			size_t use_clock=0;
+			std::mutex operand_mutex;
 
-					try{
-						if(n_1 != m_2) // Check if inner dimensions of the Matrices Match. If not then Throw error.
-						{
-							throw "Matrix Inner Dimensions don't match !!! \n";
-						}
-					  }catch (const char* msg)
-						{
-							std::cerr<<msg<<'\n';
-							exit(0);
-						}
+			ServiceStats counters;
+			std::mutex stats_mutex;
 
-						int max_n= std::max(std::max(m_1,n_1),n_2); // Find the max of all the Matrix dimensions, to find the next highest power of 2.
-						int dim_n=1;
+			int listen_fd=-1; // Guarded by clients_mutex, stop() may run on any thread
+			std::atomic<bool> running{false};
+			std::set<int> clients;
+			std::map<int,std::thread> connections; // Connection threads by socket, finished ones are joined by the accept loop
+			std::vector<std::thread> finished;
+			std::mutex clients_mutex;
 
-						// Find the next highest power of 2 using left shift operator (dim_n = Next highest power of 2).
-						// This will be used to pad zeros to both matrices A and B, and ultimately given as input to StrassenMultiply() function.
-						while(dim_n<max_n)
+			// Join the connection threads that are done, so a long running service doesn't keep one finished thread per request.
+			void reap_connections()
+			{
+				std::vector<std::thread> done;
+				{
+					std::unique_lock<std::mutex> lock(clients_mutex);
+					done.swap(finished);
+				}
+				for(std::thread &t: done)
+				{
+					t.join();
+				}
+			}
+
+			// Parsed operand of a "file:" or "shm:" spec, file operands come from the warm cache when unchanged.
+			std::shared_ptr<const Operand> operand(const std::string &spec)
+			{
+				if(spec.compare(0,4,"shm:")==0)
+				{
+					return std::make_shared<const Operand>(load_shm<Data1>(spec.substr(4)));
+				}
+				std::string path= (spec.compare(0,5,"file:")==0)? spec.substr(5) : spec;
+				std::error_code err;
+				uintmax_t size=std::filesystem::file_size(path,err);
+				if(err)
+				{
+					throw std::runtime_error("File path: '"+path+"' doesn't exist");
+				}
+				long long mtime=(long long)std::filesystem::last_write_time(path,err).time_since_epoch().count();
+				{
+					std::unique_lock<std::mutex> lock(operand_mutex);
+					typename std::map<std::string,CachedOperand>::iterator it=operands.find(path);
+					if(it!=operands.end() && it->second.size==size && it->second.mtime==mtime)
+					{
+						it->second.last_use=++use_clock;
+						std::unique_lock<std::mutex> stats_lock(stats_mutex);
+						counters.operand_hits++;
+						return it->second.MAT;
+					}
+				}
+				std::shared_ptr<const Operand> MAT=std::make_shared<const Operand>(engine.read_CSV(path));
+				size_t bytes=0;
+				for(const std::vector<Data1> &row: *MAT)
+				{
+					bytes+=row.size()*sizeof(Data1);
+				}
+				std::unique_lock<std::mutex> lock(operand_mutex);
+				{
+					std::unique_lock<std::mutex> stats_lock(stats_mutex);
+					counters.operand_misses++;
+				}
+				typename std::map<std::string,CachedOperand>::iterator old=operands.find(path);
+				if(old!=operands.end())
+				{
+					operand_bytes-=old->second.bytes;
+					operands.erase(old);
+				}
+				while(!operands.empty() && operand_bytes+bytes>operand_cache_bytes) // Evict the least recently used operands
+				{
+					typename std::map<std::string,CachedOperand>::iterator lru=operands.begin();
+					for(typename std::map<std::string,CachedOperand>::iterator it=operands.begin();it!=operands.end();++it)
+					{
+						if(it->second.last_use<lru->second.last_use)
 						{
-							dim_n=dim_n<<1;
+							lru=it;
 						}
+					}
+					operand_bytes-=lru->second.bytes;
+					operands.erase(lru);
+				}
+				if(bytes<=operand_cache_bytes)
+				{
+					operands[path]={size,mtime,MAT,bytes,++use_clock};
+					operand_bytes+=bytes;
+				}
+				return MAT;
+			}
 
-						// Initialize 3 pointers to point at Matrices A and B, and to store the Result of AxB into C.
-						Data1 ** A;
-						Data1 ** B;
-						Data1 ** C;
-
-						A=Init_matrix(dim_n); // Allocate the memory for Matrix A of size dim_n
-						B=Init_matrix(dim_n); // Allocate the memory for Matrix B of size dim_n
-
-						// Build the Zero padded square Matrices A and B by copying contents from from MAT_1 and MAT_2 into A and B respectively.
-							for(int k=0;k<m_1;k++)
-							{
-								for(int l=0;l<n_1;l++)
-								{
-									A[k][l]= MAT_1[k][l];
-								}
-							}
+			// Store a result to a "file:" or "shm:" spec.
+			void store(const std::string &spec, const Operand &C)
+			{
+				if(spec.compare(0,4,"shm:")==0)
+				{
+					store_shm<Data1>(spec.substr(4),C);
+					return;
+				}
+				std::string path= (spec.compare(0,5,"file:")==0)? spec.substr(5) : spec;
+				if(!store_csv<Data1>(C,path))
+				{
+					throw std::runtime_error("Can't write to file path: '"+path+"'");
+				}
+			}
 
-							for(int k=0;k<m_2;k++)
+			// Run one request line and return the reply line (without '\n').
+			std::string handle(const std::string &line)
+			{
+				std::vector<std::string> fields;
+				std::stringstream lineStream(line);
+				std::string field;
+				while(std::getline(lineStream,field,'\t'))
+				{
+					fields.push_back(field);
+				}
+				if(fields.empty())
+				{
+					throw std::runtime_error("Empty request");
+				}
+				const std::string &command=fields[0];
+				std::ostringstream reply;
+				if(command=="PING")
+				{
+					return "OK";
+				}
+				if(command=="SHUTDOWN")
+				{
+					stop();
+					return "OK";
+				}
+				if(command=="STATS")
+				{
+					ServiceStats s=stats();
+					size_t answered=std::max<size_t>(s.requests,1);
+					reply<<"OK requests="<<s.requests<<" errors="<<s.errors<<" mean_latency_ms="<<1e3*s.total_latency/answered
+						<<" max_latency_ms="<<1e3*s.max_latency<<" gflops="<<((s.compute_time>0)? s.flops/s.compute_time*1e-9 : 0.0)
+						<<" operand_hits="<<s.operand_hits<<" operand_misses="<<s.operand_misses;
+					return reply.str();
+				}
+				if(command=="MATMUL" && fields.size()==4)
+				{
+					std::shared_ptr<const Operand> MAT_1=operand(fields[1]);
+					std::shared_ptr<const Operand> MAT_2=operand(fields[2]);
+					if(MAT_1->empty() || MAT_2->empty() || (*MAT_1)[0].size()!=MAT_2->size())
+					{
+						throw std::runtime_error("Matrix Inner Dimensions don't match !!!");
+					}
+					std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+					Operand C;
+					{
+						std::unique_lock<std::mutex> lock(compute_mutex);
+						C=engine.block_product(*MAT_1,*MAT_2,buffers,pool);
+					}
+					std::chrono::duration<double> elapsed=std::chrono::steady_clock::now()-start;
+					{
+						std::unique_lock<std::mutex> lock(stats_mutex);
+						counters.flops+=2.0*MAT_1->size()*MAT_2->size()*(*MAT_2)[0].size();
+						counters.compute_time+=elapsed.count();
+					}
+					store(fields[3],C);
+					reply<<"OK "<<C.size()<<" "<<C[0].size()<<" "<<elapsed.count();
+					return reply.str();
+				}
+				if(command=="TRANSPOSE" && fields.size()==3)
+				{
+					std::shared_ptr<const Operand> MAT=operand(fields[1]);
+					if(MAT->empty())
+					{
+						throw std::runtime_error("Empty Matrix");
+					}
+					std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+					size_t m=MAT->size(), n=(*MAT)[0].size();
+					Operand T(n,std::vector<Data1>(m));
+					parallel_for(pool,0,n,[&](size_t lo, size_t hi){
+						for(size_t j=lo;j<hi;j++)
+						{
+							for(size_t i=0;i<m;i++)
 							{
-								for(int l=0;l<n_2;l++)
-								{
-									B[k][l]= MAT_2[k][l];
-
-								}
-
+								T[j][i]=(*MAT)[i][j];
 							}
+						}
+					});
+					std::chrono::duration<double> elapsed=std::chrono::steady_clock::now()-start;
+					{
+						std::unique_lock<std::mutex> lock(stats_mutex);
+						counters.compute_time+=elapsed.count();
+					}
+					store(fields[2],T);
+					reply<<"OK "<<n<<" "<<m<<" "<<elapsed.count();
+					return reply.str();
+				}
+				throw std::runtime_error("Unknown request '"+command+"'");
+			}
 
-						//Call Strassen's Algorithm function to get A x B and store in C.
-							C=StrassenMultiply(A, B, dim_n);
+			// Serve the requests of one connection until the client disconnects or the service stops.
+			void serve_client(int fd)
+			{
+				std::string pending;
+				char chunk[4096];
+				while(running)
+				{
+					size_t end=pending.find('\n');
+					if(end==std::string::npos)
+					{
+						ssize_t got=read(fd,chunk,sizeof(chunk));
+						if(got<=0)
+						{
+							break;
+						}
+						pending.append(chunk,got);
+						continue;
+					}
+					std::string line=pending.substr(0,end);
+					pending.erase(0,end+1);
+					if(!line.empty() && line.back()=='\r')
+					{
+						line.pop_back();
+					}
 
-						if(print==true) // if print is true then print A, B and the result A.
-							{
-									std::cout<<"A: \n";
-									print_Mat(A, m_1, n_1); //Call the print_Mat function to print the Matrix
+					std::chrono::steady_clock::time_point start=std::chrono::steady_clock::now();
+					std::string reply;
+					bool failed=false;
+					try{
+						reply=handle(line);
+					}catch (const std::exception &err)
+					{
+						reply=std::string("ERR ")+err.what();
+						failed=true;
+					}
+					std::chrono::duration<double> latency=std::chrono::steady_clock::now()-start;
+					{
+						std::unique_lock<std::mutex> lock(stats_mutex);
+						counters.requests++;
+						counters.errors+= failed? 1 : 0;
+						counters.total_latency+=latency.count();
+						counters.max_latency=std::max(counters.max_latency,latency.count());
+					}
+					reply.erase(std::remove(reply.begin(),reply.end(),'\n'),reply.end());
+					reply+='\n';
+					if(send(fd,reply.data(),reply.size(),MSG_NOSIGNAL)!=(ssize_t)reply.size())
+					{
+						break;
+					}
+				}
+				std::unique_lock<std::mutex> lock(clients_mutex);
+				clients.erase(fd);
+				typename std::map<int,std::thread>::iterator self=connections.find(fd);
+				if(self!=connections.end()) // Hand the own thread to the accept loop for joining.
+				{
+					finished.push_back(std::move(self->second));
+					connections.erase(self);
+				}
+				close(fd);
+			}
 
-									std::cout<<"\nB: \n";
-									print_Mat(B, m_2, n_2); //Call the print_Mat function to print the Matrix
+			public:
 
-									std::cout<<"\nANSWER: \n"; //Call the print_Mat function to print the Matrix
-									print_Mat(C, m_1, n_2);
+			/**
+			 * @brief Constructs the service. The LEAF_SIZE is read once here (see MATOPS::BigMatrix<Data1>::set_configerd_Leaf_size) and kept.
+			 * @param path = Path of the Unix domain socket, Eg. "/tmp/matops.sock"
+			 * @param n_threads = No. of worker threads, 0 picks the number of hardware threads.
+			 * @param cache_bytes = Upper bound on the parsed file operands kept warm
+			 */
+			MatmulService(const std::string &path, size_t n_threads=0, size_t cache_bytes=size_t(1)<<30)
+				:socket_path(path),pool(n_threads),operand_cache_bytes(cache_bytes)
+			{
+				#ifndef SET_LEAF_SIZE
+					engine.set_configerd_Leaf_size();
+				#endif
+				engine.set_LEAF_SIZE(engine.LEAF_SIZE); // Pin it, configure.txt is not read again
+			}
 
-							}
+			MatmulService(const MatmulService&) = delete;
+			MatmulService& operator=(const MatmulService&) = delete;
 
-						// Store the Result C into a CSV file, whose location is given by "path"
-						store_csv<Data1>(C, m_1,n_2,path);
+			/**
+			 * Destructor: stops the service and releases the scratch buffers.
+			 */
+			~MatmulService()
+			{
+				stop();
+				engine.Free_pad_buffers(buffers);
+			}
 
-						// Free The memory before quitting
-						for(int i=0;i<dim_n;i++)
+			/**
+			 * @brief Listen on the socket and serve requests until stop() is called or a SHUTDOWN request arrives. Every connection is served by its own
+			 * thread; requests of one connection are answered in order.
+			 *
+			 * Throws std::runtime_error if the socket can't be created.
+			 */
+			void run()
+			{
+				int fd=socket(AF_UNIX,SOCK_STREAM,0);
+				sockaddr_un address;
+				memset(&address,0,sizeof(address));
+				address.sun_family=AF_UNIX;
+				if(fd<0 || socket_path.size()>=sizeof(address.sun_path))
+				{
+					if(fd>=0)
+					{
+						close(fd);
+					}
+					throw std::runtime_error("Can't create socket '"+socket_path+"'");
+				}
+				strncpy(address.sun_path,socket_path.c_str(),sizeof(address.sun_path)-1);
+				unlink(socket_path.c_str());
+				if(bind(fd,(sockaddr*)&address,sizeof(address))!=0 || listen(fd,64)!=0)
+				{
+					close(fd);
+					throw std::runtime_error("Can't listen on socket '"+socket_path+"'");
+				}
+				{
+					std::unique_lock<std::mutex> lock(clients_mutex);
+					listen_fd=fd;
+				}
+				running=true;
+				while(running)
+				{
+					int client=accept(fd,NULL,NULL);
+					reap_connections();
+					if(client<0)
+					{
+						if(errno==EINTR)
 						{
-							free(A[i]);
-							free(B[i]);
-							free(C[i]);
+							continue;
 						}
+						break;
+					}
+					std::unique_lock<std::mutex> lock(clients_mutex);
+					clients.insert(client);
+					connections[client]=std::thread(&MatmulService::serve_client,this,client);
+				}
+				stop();
+				std::map<int,std::thread> open;
+				{
+					std::unique_lock<std::mutex> lock(clients_mutex);
+					open.swap(connections);
+					listen_fd=-1;
+				}
+				for(std::pair<const int,std::thread> &t: open)
+				{
+					t.second.join();
+				}
+				reap_connections();
+				close(fd);
+				unlink(socket_path.c_str());
+			}
 
-						free(A);
-						free(B);
-						free(C);
-
-
-				} // matmul function ends here
+			/**
+			 * @brief Stop the service: run() stops accepting connections, the open connections are closed after their current request and run() returns.
+			 */
+			void stop()
+			{
+				running=false;
+				std::unique_lock<std::mutex> lock(clients_mutex);
+				if(listen_fd>=0)
+				{
+					shutdown(listen_fd,SHUT_RDWR);
+				}
+				for(int fd: clients)
+				{
+					shutdown(fd,SHUT_RD);
+				}
+			}
 
-		// Matrix Transpose function begins here
+			/**
+			 * @return Returns a snapshot of the latency and throughput counters.
+			 */
+			ServiceStats stats()
+			{
+				std::unique_lock<std::mutex> lock(stats_mutex);
+				return counters;
+			}
+		};
 
 		/**
-		 *
-		 * @brief This is a function to find the Transpose of a BigMatrix and stores it in a csv file.
-		 * @param path = "path/to/A.csv"
-		 * @param str_path = path to store the Transpose of BigMatrix A.
-		 *
+		 * @brief Client of a MATOPS::MatmulService. Every call sends one request over the Unix domain socket and waits for its reply.
 		 */
-		void Transpose(std::string path, std::string str_path)
+		class MatmulClient
+		{
+			int fd=-1;
+			std::string pending;
+
+			public:
+
+			/**
+			 * @brief Connect to a running service.
+			 * @param path = Path of the service's Unix domain socket
+			 *
+			 * Throws std::runtime_error if the service can't be reached.
+			 */
+			explicit MatmulClient(const std::string &path)
 			{
-			    std::vector<std::vector<Data1>> MAT= load_CSV(path); // Load the Matrix from CSV file
+				sockaddr_un address;
+				memset(&address,0,sizeof(address));
+				address.sun_family=AF_UNIX;
+				fd=socket(AF_UNIX,SOCK_STREAM,0);
+				if(fd<0 || path.size()>=sizeof(address.sun_path))
+				{
+					throw std::runtime_error("Can't create socket for '"+path+"'");
+				}
+				strncpy(address.sun_path,path.c_str(),sizeof(address.sun_path)-1);
+				if(connect(fd,(sockaddr*)&address,sizeof(address))!=0)
+				{
+					close(fd);
+					fd=-1;
+					throw std::runtime_error("Can't connect to service at '"+path+"'");
+				}
+			}
 
-			    Data1** A= (Data1 **)calloc(MAT[0].size(),sizeof(Data1*));
+			MatmulClient(const MatmulClient&) = delete;
+			MatmulClient& operator=(const MatmulClient&) = delete;
 
-			    for(int i=0;i<MAT[0].size();i++)
+			/**
+			 * Destructor: closes the connection.
+			 */
+			~MatmulClient()
+			{
+				if(fd>=0)
 				{
-					A[i]=(Data1*)calloc(MAT.size(),sizeof(Data1));
+					close(fd);
 				}
+			}
 
-				for(int i=0;i<MAT.size();i++)
+			/**
+			 * @brief Send a raw request (fields separated by tabs, see MATOPS::MatmulService) and wait for the reply.
+			 * @return The reply line without its "OK" prefix. Throws std::runtime_error with the service's message if the reply is "ERR ...".
+			 */
+			std::string request(const std::string &line)
+			{
+				std::string message=line+"\n";
+				if(send(fd,message.data(),message.size(),MSG_NOSIGNAL)!=(ssize_t)message.size())
 				{
-					for(int j=0;j<MAT[0].size();j++)
+					throw std::runtime_error("Lost the connection to the service");
+				}
+				char chunk[4096];
+				size_t end;
+				while((end=pending.find('\n'))==std::string::npos)
+				{
+					ssize_t got=read(fd,chunk,sizeof(chunk));
+					if(got<=0)
 					{
-						A[j][i]=MAT[i][j];
+						throw std::runtime_error("Lost the connection to the service");
 					}
+					pending.append(chunk,got);
 				}
-
-				store_csv<Data1>(A,MAT[0].size(),MAT.size(),str_path);
-				for(int i=0;i<MAT[0].size();i++)
+				std::string reply=pending.substr(0,end);
+				pending.erase(0,end+1);
+				if(reply.compare(0,4,"ERR ")==0)
 				{
-					free(A[i]);
+					throw std::runtime_error(reply.substr(4));
 				}
-				free(A);
+				return (reply.size()>3)? reply.substr(3) : "";
 			}
 
-		/**
-		 * @brief This is a function to find the Transpose of a BigMatrix and stores it in the same csv file (In-palce transpose).
-		 * @param path = "path/to/A.csv"
-		 */
-		void Transpose(std::string path)
-					{
-					    std::vector<std::vector<Data1>> MAT= load_CSV(path); // Load the Matrix from CSV file
-
-					    Data1** A= (Data1 **)calloc(MAT[0].size(),sizeof(Data1*));
-
-					    for(int i=0;i<MAT[0].size();i++)
-						{
-							A[i]=(Data1*)calloc(MAT.size(),sizeof(Data1));
-						}
+			/**
+			 * @brief C = A x B. Operands and result are csv paths or "shm:<name>" shared memory segments (see MATOPS::store_shm).
+			 * @return The reply "<rows> <cols> <seconds>".
+			 */
+			std::string matmul(const std::string &A, const std::string &B, const std::string &C)
+			{
+				return request("MATMUL\t"+A+"\t"+B+"\t"+C);
+			}
 
-						for(int i=0;i<MAT.size();i++)
-						{
-							for(int j=0;j<MAT[0].size();j++)
-							{
-								A[j][i]=MAT[i][j];
-							}
-						}
+			/**
+			 * @brief C = A^T. Operand and result are csv paths or "shm:<name>" shared memory segments.
+			 * @return The reply "<rows> <cols> <seconds>".
+			 */
+			std::string transpose(const std::string &A, const std::string &C)
+			{
+				return request("TRANSPOSE\t"+A+"\t"+C);
+			}
 
-						store_csv<Data1>(A,MAT[0].size(),MAT.size(),path);
-						store_csv<Data1>(A,MAT[0].size(),MAT.size(),path);
+			/**
+			 * @return Returns the service's counters as key=value pairs.
+			 */
+			std::string stats()
+			{
+				return request("STATS");
+			}
 
-						for(int i=0;i<MAT[0].size();i++)
-						{
-							free(A[i]);
-						}
-						free(A);
+			/**
+			 * @brief Check that the service answers.
+			 */
+			void ping()
+			{
+				request("PING");
+			}
 
-					}
+			/**
+			 * @brief Stop the service.
+			 */
+			void shutdown()
+			{
+				request("SHUTDOWN");
+			}
+		};
+		#endif
 
-			};
+		#ifdef MATOPS_HAVE_TUNED_CONFIG
+		/**
+		 * @brief BigMatrix with the LEAF_SIZE found by configure_lib.cpp fixed at compile time (see matrix_config.h).
+		 */
+		template<typename Data1>
+		using TunedBigMatrix=BigMatrix<Data1,TUNED_LEAF_SIZE>;
+		#endif
 
 
 }  // MATOPS namespace ends here
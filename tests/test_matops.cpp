@@ -0,0 +1,754 @@
+/**
+ * @file   test_matops.cpp
+ * @brief  Checks the BigMatrix entry points against a naive triple loop product.
+ *
+ * Build and run from the root of the repository (Linux, the distributed product and the service need fork, shared memory and Unix sockets):
+ *
+ *     g++ -std=c++17 -O2 -I. tests/test_matops.cpp -o test_matops -pthread && ./test_matops
+ *
+ * The operands and a configure.txt (LEAF_SIZE 16, small enough for the Strassen recursion to run on the test sizes) are written to a temporary
+ * directory that is removed at the end. Prints one line per failed check and exits with 1 if any check failed. A watchdog
+ * alarm turns a deadlock (Eg. in matmul_batch) into a failure instead of a hang.
+ */
+
+#include<iostream>
+#include<random>
+#include<complex>
+#include<thread>
+#include<chrono>
+#include<functional>
+#include "matrix.h"
+
+using namespace MATOPS;
+
+typedef std::vector<std::vector<double>> Mat;
+
+static int failures=0;
+static std::string dir;
+
+#define CHECK(cond, what) do{ if(!(cond)){ std::cout<<"FAILED: "<<(what)<<" ("<<__FILE__<<":"<<__LINE__<<")\n"; failures++; } }while(0)
+
+/**
+ * @brief Random rows x cols Matrix of small integers, so that every product is exact in double.
+ */
+Mat random_matrix(size_t rows, size_t cols, unsigned seed, double density=1.0)
+{
+	std::mt19937 gen(seed);
+	std::uniform_int_distribution<int> value(-5,5);
+	std::uniform_real_distribution<double> keep(0,1);
+	Mat A(rows,std::vector<double>(cols,0));
+	for(auto &row: A)
+	{
+		for(auto &x: row)
+		{
+			x=(keep(gen)<density)? value(gen) : 0;
+		}
+	}
+	return A;
+}
+
+Mat naive(const Mat &A, const Mat &B)
+{
+	Mat C(A.size(),std::vector<double>(B[0].size(),0));
+	for(size_t i=0;i<A.size();i++)
+	{
+		for(size_t l=0;l<B.size();l++)
+		{
+			for(size_t j=0;j<B[0].size();j++)
+			{
+				C[i][j]+=A[i][l]*B[l][j];
+			}
+		}
+	}
+	return C;
+}
+
+/**
+ * @brief Largest absolute difference of two Matrices, infinity if the shapes differ.
+ */
+double max_diff(const Mat &A, const Mat &B)
+{
+	if(A.size()!=B.size() || (!A.empty() && A[0].size()!=B[0].size()))
+	{
+		return INFINITY;
+	}
+	double d=0;
+	for(size_t i=0;i<A.size();i++)
+	{
+		for(size_t j=0;j<A[i].size();j++)
+		{
+			d=std::max(d,std::fabs(A[i][j]-B[i][j]));
+		}
+	}
+	return d;
+}
+
+std::string file(const std::string &name)
+{
+	return dir+"/"+name;
+}
+
+std::string write(const std::string &name, const Mat &A)
+{
+	store_csv(A,file(name));
+	return file(name);
+}
+
+Mat read(const std::string &path)
+{
+	BigMatrix<double> M;
+	return M.load(path).to_vector();
+}
+
+/**
+ * @brief Run f in a child process with its output muted. The file functions report bad input by printing the error and calling exit(0),
+ * so returns true if f exited that way, false if it returned normally or crashed.
+ */
+bool exits_with_error(const std::function<void()> &f)
+{
+	std::cout.flush();
+	pid_t pid=fork();
+	if(pid==0)
+	{
+		std::cout.setstate(std::ios::failbit);
+		std::cerr.setstate(std::ios::failbit);
+		f();
+		_exit(2);
+	}
+	int status=0;
+	waitpid(pid,&status,0);
+	return WIFEXITED(status) && WEXITSTATUS(status)==0;
+}
+
+void test_parallel_for()
+{
+	ThreadPool pool(3);
+	std::vector<long long> partial(64,0);
+	// Nested loops on the same pool: the caller runs chunks itself, so no task waits on a task queued behind it.
+	parallel_for(pool,0,64,[&](size_t begin, size_t end){
+		for(size_t i=begin;i<end;i++)
+		{
+			std::atomic<long long> s{0};
+			parallel_for(pool,0,1000,[&s](size_t b, size_t e){
+				for(size_t j=b;j<e;j++)
+				{
+					s+=j;
+				}
+			});
+			partial[i]=s;
+		}
+	});
+	for(long long s: partial)
+	{
+		CHECK(s==499500,"nested parallel_for");
+	}
+	bool thrown=false;
+	try{
+		parallel_for(pool,0,100,[](size_t begin, size_t end){
+			if(begin<=42 && 42<end)
+			{
+				throw std::runtime_error("42");
+			}
+		});
+	}catch (const std::runtime_error&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"parallel_for rethrows");
+}
+
+void test_small_gemm()
+{
+	Matrix<double,2,2> A{{1,2},{3,4}}, B{{0,1},{1,0}}, C{{1,1},{1,1}};
+	gemm<true,false>(2.0,A,B,1.0,C); // 2 A^T B + C
+	CHECK(C.ElementAt(0,0)==7 && C.ElementAt(0,1)==3 && C.ElementAt(1,0)==9 && C.ElementAt(1,1)==5,"gemm<true,false>");
+	Matrix<double,2,3> D{{1,2,3},{4,5,6}};
+	Matrix<double,2,2> E;
+	gemm<false,true>(1.0,D,D,0.0,E); // D D^T
+	CHECK(E.ElementAt(0,0)==14 && E.ElementAt(0,1)==32 && E.ElementAt(1,0)==32 && E.ElementAt(1,1)==77,"gemm<false,true>");
+	// C aliasing an operand
+	gemm<false,false>(1.0,A,A,0.0,A);
+	CHECK(A.ElementAt(0,0)==7 && A.ElementAt(0,1)==10 && A.ElementAt(1,0)==15 && A.ElementAt(1,1)==22,"gemm with C == A == B");
+	gemm<false,false>(1.0,B,A,1.0,A); // A = B A + A
+	CHECK(A.ElementAt(0,0)==22 && A.ElementAt(0,1)==32 && A.ElementAt(1,0)==22 && A.ElementAt(1,1)==32,"gemm with C == B and beta");
+}
+
+void test_huge_alloc()
+{
+	// Mapped (with the transparent huge page fallback when no huge pages are reserved) and calloc blocks: zeroed, aligned and writable.
+	for(size_t bytes: {size_t(100),HUGE_PAGE_SIZE-10,size_t(3)<<20})
+	{
+		char* block=(char*)huge_alloc(bytes);
+		CHECK((uintptr_t)block%64==0,"huge_alloc alignment");
+		CHECK(block[0]==0 && block[bytes/2]==0 && block[bytes-1]==0,"huge_alloc zeroed");
+		block[bytes-1]=1;
+		huge_free(block);
+	}
+	huge_free(NULL);
+	bool thrown=false;
+	try{
+		huge_alloc(SIZE_MAX-8);
+	}catch (const std::bad_alloc&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"huge_alloc rejects a size that overflows");
+}
+
+void test_dynmatrix()
+{
+	Mat A=random_matrix(37,53,1), B=random_matrix(53,29,2);
+	DynMatrix<double> DA(A), DB(B);
+	DynMatrix<double> DC=DA*DB;
+	CHECK(max_diff(DC.to_vector(),naive(A,B))==0,"DynMatrix product");
+	CHECK(max_diff(DA.transpose().transpose().to_vector(),A)==0,"DynMatrix transpose");
+
+	// Moving a heap backed Matrix hands over its buffer, clone() copies it.
+	const double* buffer=DC.data();
+	DynMatrix<double> moved=std::move(DC);
+	CHECK(moved.data()==buffer && DC.rows()==0,"DynMatrix move");
+	DynMatrix<double> copy=moved.clone();
+	CHECK(copy.data()!=buffer && max_diff(copy.to_vector(),moved.to_vector())==0,"DynMatrix clone");
+
+	// Inline storage and conversions to and from class Matrix.
+	DynMatrix<double> small{{1,2},{3,4}};
+	Matrix<double,2,2> S=(small*small).to_matrix<2,2>();
+	CHECK(S.ElementAt(0,0)==7 && S.ElementAt(1,1)==22,"DynMatrix inline product");
+	CHECK(DynMatrix<double>(S).ElementAt(1,0)==15,"DynMatrix from Matrix");
+
+	bool thrown=false;
+	try{
+		DynMatrix<double> huge(SIZE_MAX/4,3);
+	}catch (const std::length_error&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"DynMatrix rejects a size_t overflow");
+	thrown=false;
+	try{
+		DA*DA;
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"DynMatrix rejects mismatched inner dimensions");
+}
+
+void test_matmul()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(37,53,1), B=random_matrix(53,29,2);
+	M.matmul(write("A.csv",A),write("B.csv",B),file("C.csv"));
+	CHECK(max_diff(read(file("C.csv")),naive(A,B))==0,"matmul");
+
+	M.gemm(file("A.csv"),file("A.csv"),file("AtA.csv"),true,false);
+	Mat At(53,std::vector<double>(37));
+	for(size_t i=0;i<37;i++)
+	{
+		for(size_t j=0;j<53;j++)
+		{
+			At[j][i]=A[i][j];
+		}
+	}
+	CHECK(max_diff(read(file("AtA.csv")),naive(At,A))==0,"gemm A^T A");
+	CHECK(exits_with_error([&](){ M.gemm(file("A.csv"),file("A.csv"),"/dev/full",true,false); }),"gemm reports a failed write");
+
+	Mat v=random_matrix(53,2,3);
+	M.matmul_gemv(file("A.csv"),write("v.csv",v),file("Av.csv"),3);
+	CHECK(max_diff(read(file("Av.csv")),naive(A,v))==0,"matmul_gemv");
+
+	// Bad operands are reported, never read out of range.
+	std::ofstream(file("empty.csv")).close();
+	std::ofstream ragged(file("ragged.csv"));
+	ragged<<"1,2\n3\n";
+	ragged.close();
+	CHECK(exits_with_error([&](){ M.matmul_gemv(file("A.csv"),file("empty.csv"),file("bad.csv")); }),"matmul_gemv rejects an empty B");
+	CHECK(exits_with_error([&](){ M.matmul_gemv(file("ragged.csv"),file("ragged.csv"),file("bad.csv")); }),"matmul_gemv rejects ragged rows");
+	CHECK(exits_with_error([&](){ M.matmul_gemv(file("empty.csv"),file("v.csv"),file("bad.csv")); }),"matmul_gemv rejects an empty A");
+	CHECK(exits_with_error([&](){ M.matmul(file("A.csv"),file("empty.csv"),file("bad.csv")); }),"matmul rejects an empty B");
+
+	// A blank first line in B must not send a 2 column B down the 1 column path.
+	std::ofstream blank_first(file("blank_first.csv"));
+	blank_first<<"\n1,2\n3,4\n";
+	blank_first.close();
+	M.matmul(write("X2.csv",{{1,0},{2,1}}),file("blank_first.csv"),file("X2B.csv"));
+	CHECK(max_diff(read(file("X2B.csv")),{{1,2},{5,8}})==0,"matmul with a blank first line in B");
+
+	Mat C=random_matrix(29,7,4);
+	CHECK(max_diff(M.multiply_chain({A,B,C}),naive(naive(A,B),C))==0,"multiply_chain");
+
+	// (X Y) Z is ~100x cheaper than X (Y Z) here, both must give the same product.
+	Mat X=random_matrix(3,60,16), Y=random_matrix(60,2,17), Z=random_matrix(2,70,18), W=random_matrix(70,5,19);
+	Mat XYZW=naive(naive(naive(X,Y),Z),W);
+	CHECK(max_diff(M.multiply_chain({X,Y,Z,W}),XYZW)==0,"multiply_chain with uneven shapes");
+	CHECK(max_diff(M.multiply_chain({X}),X)==0,"multiply_chain of one Matrix");
+	M.matmul_chain({write("X.csv",X),write("Y.csv",Y),write("Z.csv",Z),write("W.csv",W)},file("XYZW.csv"));
+	CHECK(max_diff(read(file("XYZW.csv")),XYZW)==0,"matmul_chain");
+	bool thrown=false;
+	try{
+		M.multiply_chain({});
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"multiply_chain rejects an empty chain");
+	thrown=false;
+	try{
+		M.multiply_chain({X,Z});
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"multiply_chain rejects mismatched shapes");
+	CHECK(exits_with_error([&](){ M.matmul_chain({file("X.csv"),file("Z.csv")},file("bad.csv")); }),"matmul_chain rejects mismatched shapes");
+	CHECK(exits_with_error([&](){ M.matmul_chain({},file("bad.csv")); }),"matmul_chain rejects an empty chain");
+}
+
+void test_static_leaf_size()
+{
+	BigMatrix<double,16> M;
+	Mat A=random_matrix(70,45,20), B=random_matrix(45,33,21);
+	M.matmul(write("A16.csv",A),write("B16.csv",B),file("C16.csv"));
+	CHECK(max_diff(read(file("C16.csv")),naive(A,B))==0,"matmul with a static LEAF_SIZE");
+	M.set_LEAF_SIZE(16);
+	bool thrown=false;
+	try{
+		M.set_LEAF_SIZE(32);
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"set_LEAF_SIZE rejects a value other than the static LEAF_SIZE");
+	#ifdef MATOPS_HAVE_TUNED_CONFIG
+	TunedBigMatrix<double> T;
+	T.matmul(file("A16.csv"),file("B16.csv"),file("CT.csv"));
+	CHECK(max_diff(read(file("CT.csv")),naive(A,B))==0,"TunedBigMatrix matmul");
+	#endif
+}
+
+void test_csv_index()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(300,12,22);
+	write("I.csv",A);
+	CsvIndex index=M.index_CSV(file("I.csv"));
+	CHECK(index.rows()==300 && index.cols()==12,"index_CSV shape");
+	CHECK(std::filesystem::exists(file("I.csv.idx")),"index_CSV writes the sidecar");
+	std::vector<size_t> split=index.split_points(4);
+	bool ordered=(split.size()==5 && split.front()==0 && split.back()==300);
+	for(size_t p=1;p<split.size();p++)
+	{
+		ordered=ordered && split[p-1]<=split[p];
+	}
+	CHECK(ordered,"split_points");
+
+	Mat S=M.load_submatrix(file("I.csv"),100,137,3,9), expected;
+	for(size_t i=100;i<137;i++)
+	{
+		expected.push_back(std::vector<double>(A[i].begin()+3,A[i].begin()+9));
+	}
+	CHECK(max_diff(S,expected)==0,"load_submatrix");
+	CHECK(M.load_submatrix(file("I.csv"),5,5,0,12).empty(),"load_submatrix of no rows");
+	bool thrown=false;
+	try{
+		M.load_submatrix(file("I.csv"),290,301,0,12);
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"load_submatrix rejects rows outside the Matrix");
+	thrown=false;
+	try{
+		M.load_submatrix(file("I.csv"),0,10,4,13);
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"load_submatrix rejects columns outside the Matrix");
+	thrown=false;
+	try{
+		M.load_submatrix(file("missing.csv"),0,1,0,1);
+	}catch (const std::runtime_error&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"load_submatrix reports a missing file");
+
+	// A stale sidecar (the file changed) is rebuilt, CRLF line ends and blank lines are not rows.
+	std::ofstream crlf(file("I.csv"),std::ios::binary|std::ios::trunc);
+	crlf<<"1,2,3\r\n\r\n4,5,6\r\n\n7,8,9\r\n";
+	crlf.close();
+	index=M.index_CSV(file("I.csv"));
+	CHECK(index.rows()==3 && index.cols()==3,"index_CSV rebuilds a stale sidecar and skips blank lines");
+	CHECK(max_diff(M.load_submatrix(file("I.csv"),1,3,1,3),{{5,6},{8,9}})==0,"load_submatrix with CRLF line ends");
+
+	// The sidecar written while parsing matches the one built from scratch.
+	BigMatrix<double> P;
+	P.enable_csv_index();
+	write("J.csv",A);
+	P.load(file("J.csv"));
+	CHECK(std::filesystem::exists(file("J.csv.idx")),"enable_csv_index writes the sidecar while parsing");
+	CHECK(max_diff(P.load_submatrix(file("J.csv"),250,300,0,12),Mat(A.begin()+250,A.end()))==0,"load_submatrix through the parser's sidecar");
+}
+
+void test_sparse()
+{
+	BigMatrix<double> M;
+	Mat S=random_matrix(120,90,5,0.02), D=random_matrix(90,40,6);
+	CHECK(max_diff(SparseMatrix<double>::from_dense(S).multiply(D,2),naive(S,D))==0,"SparseMatrix x dense");
+	CHECK(max_diff(SparseMatrix<double>::from_dense(S).multiply(SparseMatrix<double>::from_dense(D),2).to_dense(),naive(S,D))==0,
+			"SparseMatrix x SparseMatrix");
+	M.matmul(write("S.csv",S),write("D.csv",D),file("SD.csv"));
+	CHECK(max_diff(read(file("SD.csv")),naive(S,D))==0,"matmul with a sparse operand");
+
+	std::ofstream blank(file("blank.csv"));
+	blank<<"1,0\n\n0,2\n\n";
+	blank.close();
+	CHECK(SparseMatrix<double>::load_CSV(file("blank.csv")).rows()==2,"SparseMatrix::load_CSV skips blank lines");
+}
+
+void test_batch()
+{
+	BigMatrix<double> M;
+	Mat I(64,std::vector<double>(64,0)), D=random_matrix(64,64,7);
+	for(size_t i=0;i<64;i++)
+	{
+		I[i][i]=1;
+	}
+	write("I64.csv",I);
+	write("D64.csv",D);
+	std::vector<MatmulJob> jobs;
+	for(int j=0;j<4;j++)
+	{
+		MatmulJob job;
+		job.file_1=file("I64.csv");
+		job.file_2=file("D64.csv");
+		job.path=file("batch"+std::to_string(j)+".csv");
+		jobs.push_back(job);
+	}
+	// One worker and a budget of 1 byte: a sparse job holding the budget used to wait for nested kernels queued on the same pool.
+	for(size_t n_threads: {1,2})
+	{
+		std::vector<JobResult> results=M.matmul_batch(jobs,n_threads,1);
+		for(size_t j=0;j<jobs.size();j++)
+		{
+			CHECK(results[j].status==JobStatus::OK,"matmul_batch status");
+			CHECK(max_diff(read(jobs[j].path),D)==0,"matmul_batch result");
+		}
+	}
+
+	// A sparse operand (kept in CSR form) and operands with blank lines, which are not rows for any of the parsers.
+	Mat S=random_matrix(120,90,5,0.02), E=random_matrix(90,40,6);
+	std::ofstream blank(file("blank_lead.csv"));
+	blank<<"\n1,2\n\r\n3,4\n\n";
+	blank.close();
+	std::vector<MatmulJob> mixed(2);
+	mixed[0].file_1=write("S.csv",S);
+	mixed[0].file_2=write("E.csv",E);
+	mixed[0].path=file("batchSE.csv");
+	mixed[1].file_1=file("blank_lead.csv");
+	mixed[1].file_2=file("blank_lead.csv");
+	mixed[1].path=file("batch_blank.csv");
+	std::vector<JobResult> results=M.matmul_batch(mixed,2);
+	CHECK(results[0].status==JobStatus::OK && max_diff(read(mixed[0].path),naive(S,E))==0,"matmul_batch with a sparse operand");
+	CHECK(results[1].status==JobStatus::OK && max_diff(read(mixed[1].path),{{7,10},{15,22}})==0,"matmul_batch skips blank lines");
+}
+
+void test_power_and_cache()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(20,20,8);
+	for(auto &row: A)
+	{
+		for(auto &x: row)
+		{
+			x=(x>2)? 1 : 0;
+		}
+	}
+	Mat P=A;
+	for(int k=1;k<5;k++)
+	{
+		P=naive(P,A);
+	}
+	CHECK(max_diff(M.power(A,5,2),P)==0,"power");
+
+	BigMatrix<double> cached;
+	cached.enable_cache(file("cache"),1<<20);
+	cached.matmul(file("A.csv"),file("B.csv"),file("C1.csv"));
+	cached.matmul(file("A.csv"),file("B.csv"),file("C2.csv"));
+	CHECK(cached.result_cache()->hits()==1 && cached.result_cache()->misses()==1,"result cache hit");
+	CHECK(max_diff(read(file("C2.csv")),read(file("C.csv")))==0,"cached result");
+
+	// Room for two results: the least recently used one is evicted.
+	uintmax_t entry=std::filesystem::file_size(file("C.csv"));
+	ResultCache cache(file("small_cache"),2*entry+entry/2);
+	std::string k1=cache.key("matmul",{file("A.csv")},"1"), k2=cache.key("matmul",{file("A.csv")},"2"), k3=cache.key("matmul",{file("A.csv")},"3");
+	CHECK(k1!=k2 && k2!=k3,"cache keys depend on the parameters");
+	cache.store(k1,file("C.csv"));
+	cache.store(k2,file("C.csv"));
+	CHECK(cache.fetch(k1,file("hit.csv")),"cache hit before eviction");
+	cache.store(k3,file("C.csv"));
+	CHECK(!cache.fetch(k2,file("miss.csv")) && !std::filesystem::exists(file("miss.csv")),"least recently used entry evicted");
+	CHECK(cache.fetch(k1,file("hit.csv")) && cache.fetch(k3,file("hit.csv")),"recently used entries kept");
+	CHECK(cache.hits()==3 && cache.misses()==1,"cache hit and miss counters");
+	uintmax_t total=0;
+	for(const std::filesystem::directory_entry &e: std::filesystem::directory_iterator(file("small_cache")))
+	{
+		if(e.path().extension()==".csv")
+		{
+			total+=e.file_size();
+		}
+	}
+	CHECK(total<=2*entry+entry/2,"cache stays within max_size");
+	write("A_changed.csv",random_matrix(3,3,23));
+	CHECK(cache.key("matmul",{file("A_changed.csv")},"1")!=k1,"cache keys depend on the input contents");
+}
+
+void test_quantized_and_distributed()
+{
+	Mat A=random_matrix(37,53,1), B=random_matrix(53,29,2);
+	std::vector<std::vector<float>> Q=quantized_multiply(A,B,Quantization::INT16,2);
+	Mat C=naive(A,B);
+	double err=0;
+	for(size_t i=0;i<C.size();i++)
+	{
+		for(size_t j=0;j<C[0].size();j++)
+		{
+			err=std::max(err,std::fabs(Q[i][j]-C[i][j]));
+		}
+	}
+	CHECK(err<53*5*5*1e-3,"quantized_multiply INT16");
+
+	BigMatrix<double> M;
+	M.matmul_distributed(file("A.csv"),file("B.csv"),file("Cd.csv"),3);
+	CHECK(max_diff(read(file("Cd.csv")),C)==0,"matmul_distributed");
+
+	// Concurrent calls from threads of one process, next to a segment left behind under this pid, each get their own segment.
+	std::string stale="/matops_"+std::to_string(getpid());
+	int fd=shm_open(stale.c_str(),O_CREAT|O_RDWR,0600);
+	std::vector<std::thread> calls;
+	for(int t=0;t<3;t++)
+	{
+		calls.emplace_back([t]{
+			BigMatrix<double> L;
+			L.matmul_distributed(file("A.csv"),file("B.csv"),file("Cd"+std::to_string(t)+".csv"),2);
+		});
+	}
+	for(std::thread &t: calls)
+	{
+		t.join();
+	}
+	for(int t=0;t<3;t++)
+	{
+		CHECK(max_diff(read(file("Cd"+std::to_string(t)+".csv")),C)==0,"concurrent matmul_distributed");
+	}
+	if(fd>=0)
+	{
+		close(fd);
+		shm_unlink(stale.c_str());
+	}
+}
+
+void test_solve_and_complex()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(150,150,9), B=random_matrix(150,3,10);
+	for(size_t i=0;i<150;i++)
+	{
+		A[i][i]+=1000;
+	}
+	CHECK(max_diff(naive(A,M.solve(A,B,2)),B)<1e-9,"solve");
+	Mat L=M.lu(A).LU;
+	CHECK(L.size()==150,"lu");
+
+	Mat I(150,std::vector<double>(150,0));
+	for(size_t i=0;i<150;i++)
+	{
+		I[i][i]=1;
+	}
+	CHECK(max_diff(naive(M.inverse(A,2),A),I)<1e-9,"inverse");
+	M.inverse(write("Asq.csv",A),file("Ainv.csv"),2);
+	CHECK(max_diff(naive(read(file("Ainv.csv")),A),I)<1e-4,"inverse of a file"); // store_csv keeps 6 significant digits
+	Mat singular={{1,2,3},{2,4,6},{1,0,1}};
+	bool thrown=false;
+	try{
+		M.inverse(singular);
+	}catch (const std::runtime_error&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"inverse rejects a singular Matrix");
+	thrown=false;
+	try{
+		M.inverse(random_matrix(3,4,24));
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"inverse rejects a non square Matrix");
+	CHECK(exits_with_error([&](){ M.inverse(write("singular.csv",singular),file("bad.csv")); }),"inverse of a singular file");
+
+	BigMatrix<double>::ComplexMatrix X, Y;
+	X.re=random_matrix(17,23,12); X.im=random_matrix(17,23,13);
+	Y.re=random_matrix(23,11,14); Y.im=random_matrix(23,11,15);
+	BigMatrix<double>::ComplexMatrix Z=M.multiply_complex(X,Y,2);
+	std::vector<std::vector<std::complex<double>>> Xi=X.to_interleaved(), Yi=Y.to_interleaved();
+	double err=0;
+	for(size_t i=0;i<17;i++)
+	{
+		for(size_t j=0;j<11;j++)
+		{
+			std::complex<double> z=0;
+			for(size_t l=0;l<23;l++)
+			{
+				z+=Xi[i][l]*Yi[l][j];
+			}
+			err=std::max(err,std::abs(z-std::complex<double>(Z.re[i][j],Z.im[i][j])));
+		}
+	}
+	CHECK(err==0,"multiply_complex");
+}
+
+void test_elementwise()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(37,53,1), B=random_matrix(37,53,16), C=random_matrix(37,53,17), E=A;
+	double sum=0;
+	for(size_t i=0;i<37;i++)
+	{
+		for(size_t j=0;j<53;j++)
+		{
+			E[i][j]=2*A[i][j]-3*B[i][j]*C[i][j];
+			sum+=A[i][j];
+		}
+	}
+	CHECK(max_diff(M.elementwise(2,A,-3,B,C,2),E)==0,"elementwise");
+	M.elementwise(2,file("A.csv"),-3,write("EB.csv",B),write("EC.csv",C),file("E.csv"),2);
+	CHECK(max_diff(read(file("E.csv")),E)==0,"streamed elementwise");
+	CHECK(M.sum(file("A.csv"),2)==sum && M.sum(A)==sum,"sum");
+
+	Mat longer=B;
+	longer.push_back(B[0]);
+	write("longer.csv",longer);
+	CHECK(exits_with_error([&](){ M.add(file("A.csv"),file("longer.csv"),file("bad.csv")); }),"streamed add rejects extra rows");
+
+	// C without B: Z must not be taken for Y.
+	Mat X={{1,2},{3,4}}, Z={{5,6},{7,8}};
+	write("X.csv",X);
+	write("Z.csv",Z);
+	CHECK(exits_with_error([&](){ M.elementwise(1,file("X.csv"),1,"",file("Z.csv"),file("XZ.csv")); }),"streamed elementwise rejects C without B");
+	CHECK(!std::filesystem::exists(file("XZ.csv")),"no result for C without B");
+	bool thrown=false;
+	try{
+		M.elementwise(1,X,1,Mat(),Z);
+	}catch (const std::invalid_argument&)
+	{
+		thrown=true;
+	}
+	CHECK(thrown,"elementwise rejects an empty B");
+	M.elementwise(0,"",2,file("X.csv"),file("Z.csv"),file("XZ.csv"));
+	CHECK(max_diff(read(file("XZ.csv")),{{10,24},{42,64}})==0,"streamed elementwise without A");
+}
+
+void test_incremental()
+{
+	BigMatrix<double> M;
+	Mat A=random_matrix(37,53,1), B=random_matrix(53,29,2);
+	BigMatrix<double>::Product P=M.make_product(A,B);
+	std::map<size_t,std::vector<double>> rows;
+	rows[3]=std::vector<double>(53,2);
+	M.update_rows(P,rows);
+	A[3]=rows[3];
+	CHECK(max_diff(P.C,naive(A,B))==0,"update_rows");
+
+	A[7]=std::vector<double>(53,-1);
+	write("A.csv",A);
+	M.matmul_update(file("A.csv"),file("B.csv"),file("C.csv"),{3,7});
+	CHECK(max_diff(read(file("C.csv")),naive(A,B))==0,"matmul_update");
+
+	// 20 copies of one index are one changed row, below the 25% threshold: only row 5 is recomputed, a full recompute would repair row 0.
+	Mat stale=read(file("C.csv"));
+	stale[0].assign(29,999);
+	write("C.csv",stale);
+	A[5]=std::vector<double>(53,4);
+	write("A.csv",A);
+	M.matmul_update(file("A.csv"),file("B.csv"),file("C.csv"),std::vector<size_t>(20,5));
+	Mat updated=read(file("C.csv")), expected=naive(A,B);
+	CHECK(updated[5]==expected[5] && updated[0]==stale[0],"matmul_update counts repeated rows once");
+	CHECK(exits_with_error([&](){ M.matmul_update(file("A.csv"),file("B.csv"),file("C.csv"),{3,37}); }),"matmul_update rejects a row outside of A");
+	write("C.csv",expected);
+}
+
+void test_service()
+{
+	std::string socket_path=file("matops.sock");
+	MatmulService<double> service(socket_path,2);
+	std::thread server([&service](){ service.run(); });
+	std::unique_ptr<MatmulClient> client;
+	for(int attempt=0;attempt<100 && !client;attempt++)
+	{
+		try{
+			client.reset(new MatmulClient(socket_path));
+		}catch (const std::runtime_error&)
+		{
+			std::this_thread::sleep_for(std::chrono::milliseconds(20));
+		}
+	}
+	CHECK(client!=nullptr,"service accepts connections");
+	if(client)
+	{
+		client->ping();
+		std::istringstream reply(client->matmul(file("A.csv"),file("B.csv"),file("Cs.csv")));
+		size_t rows=0, cols=0;
+		reply>>rows>>cols;
+		CHECK(rows==37 && cols==29,"service MATMUL reply");
+		CHECK(max_diff(read(file("Cs.csv")),naive(read(file("A.csv")),read(file("B.csv"))))==0,"service MATMUL result");
+		client->shutdown();
+	}
+	else
+	{
+		service.stop();
+	}
+	server.join();
+}
+
+int main()
+{
+	alarm(300);
+	char tmp[]="/tmp/matops_test_XXXXXX";
+	if(mkdtemp(tmp)==NULL)
+	{
+		std::cerr<<"Can't create a temporary directory\n";
+		return 1;
+	}
+	dir=tmp;
+	// The tests run in the temporary directory with their own configure.txt, so they don't depend on (or overwrite) a configured LEAF_SIZE.
+	if(chdir(tmp)!=0)
+	{
+		std::cerr<<"Can't enter '"<<dir<<"'\n";
+		return 1;
+	}
+	std::ofstream config("configure.txt");
+	config<<"16\n";
+	config.close();
+
+	test_parallel_for();
+	test_small_gemm();
+	test_huge_alloc();
+	test_dynmatrix();
+	test_matmul();
+	test_static_leaf_size();
+	test_csv_index();
+	test_sparse();
+	test_batch();
+	test_power_and_cache();
+	test_quantized_and_distributed();
+	test_solve_and_complex();
+	test_elementwise();
+	test_incremental();
+	test_service();
+
+	std::filesystem::remove_all(dir);
+	std::cout<<(failures? "FAILED" : "OK")<<" ("<<failures<<" failed checks)\n";
+	return failures? 1 : 0;
+}